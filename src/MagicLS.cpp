@@ -38,11 +38,31 @@
 #include "commands/abc/dc2.hpp"
 #include "commands/abc/ifraig.hpp"
 #include "commands/abc/dch.hpp"
+#include "commands/abc/dch_map.hpp"
 #include "commands/abc/write.hpp"
 #include "commands/abc/read_genlib.hpp"
 #include "commands/abc/strash.hpp"
 #include "commands/transform.hpp"
+#include "commands/convert_mode.hpp"
+#include "commands/exact_cache.hpp"
+#include "commands/store_hash.hpp"
+#include "commands/session.hpp"
+#include "commands/aiger.hpp"
+#include "commands/map.hpp"
+#include "commands/lut_map.hpp"
 #include "commands/abc/&fraig.hpp"
 #include "commands/abc/gia_opt.hpp"
+#include "commands/gia_lut.hpp"
+#include "commands/rewrite.hpp"
+#include "commands/depth_rewrite.hpp"
+#include "commands/resub.hpp"
+#include "commands/balance.hpp"
+#include "commands/refactor.hpp"
+#include "commands/partition_opt.hpp"
+#include "commands/memo.hpp"
+#include "commands/explore.hpp"
+#include "commands/repeat.hpp"
+#include "commands/exact.hpp"
+#include "commands/exact_resyn.hpp"
 
 ALICE_MAIN(MagicLS)
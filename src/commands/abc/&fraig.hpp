@@ -46,26 +46,31 @@ namespace alice
                 pabc::Gia_Man_t *pNtk, *pTemp;
                 pNtk = store<pabc::Gia_Man_t *>().current();
 
-                pabc::Cec_ParFra_t ParsFra, *pPars = &ParsFra;
-                // set defaults
-                memset(pPars, 0, sizeof(pabc::Cec_ParFra_t));
-                pPars->jType = 2;          // solver type
-                pPars->fSatSweeping = 1;   // conflict limit at a node
-                pPars->nWords = 4;         // simulation words
-                pPars->nRounds = 10;       // simulation rounds
-                pPars->nItersMax = 2000;   // this is a miter
-                pPars->nBTLimit = 1000000; // use logic cones
-                pPars->nBTLimitPo = 0;     // use logic outputs
-                pPars->nSatVarMax =
-                    1000; // the max number of SAT variables before recycling SAT solver
-                pPars->nCallsRecycle =
-                    500;                // calls to perform before recycling SAT solver
-                pPars->nGenIters = 100; // pattern generation iterations
-
-                pTemp = Cec_ManSatSweeping(pNtk, pPars, 0);
-
-                store<pabc::Gia_Man_t *>().extend();
-                store<pabc::Gia_Man_t *>().current() = pTemp;
+                const auto before = MagicLS::structural_hash(pNtk);
+                const auto key = MagicLS::memo_key("&fraig");
+                if (!extend_memoized(store<pabc::Gia_Man_t *>(), before, key))
+                {
+                    pabc::Cec_ParFra_t ParsFra, *pPars = &ParsFra;
+                    // set defaults
+                    memset(pPars, 0, sizeof(pabc::Cec_ParFra_t));
+                    pPars->jType = 2;          // solver type
+                    pPars->fSatSweeping = 1;   // conflict limit at a node
+                    pPars->nWords = 4;         // simulation words
+                    pPars->nRounds = 10;       // simulation rounds
+                    pPars->nItersMax = 2000;   // this is a miter
+                    pPars->nBTLimit = 1000000; // use logic cones
+                    pPars->nBTLimitPo = 0;     // use logic outputs
+                    pPars->nSatVarMax =
+                        1000; // the max number of SAT variables before recycling SAT solver
+                    pPars->nCallsRecycle =
+                        500;                // calls to perform before recycling SAT solver
+                    pPars->nGenIters = 100; // pattern generation iterations
+
+                    pTemp = Cec_ManSatSweeping(pNtk, pPars, 0);
+
+                    MagicLS::memo_cache<pabc::Gia_Man_t *>::instance().insert(before, key, pTemp);
+                    extend_unique(store<pabc::Gia_Man_t *>(), pTemp);
+                }
             }
 
             end = clock();
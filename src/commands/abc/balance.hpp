@@ -66,40 +66,45 @@ namespace alice
                     Abc_Print(-1, "Empty network.\n");
                     return;
                 }
-                // get the new network
-                if (Abc_NtkIsStrash(pNtk))
+                const auto before = MagicLS::structural_hash(pNtk);
+                const auto key = MagicLS::memo_key("abc_balance", fDuplicate, fSelective, fUpdateLevel, fExor);
+                if (!extend_memoized(store<pabc::Abc_Ntk_t *>(), before, key))
                 {
-                    if (fExor)
-                        pNtkRes = Abc_NtkBalanceExor(pNtk, fUpdateLevel, fVerbose);
+                    // get the new network
+                    if (Abc_NtkIsStrash(pNtk))
+                    {
+                        if (fExor)
+                            pNtkRes = Abc_NtkBalanceExor(pNtk, fUpdateLevel, fVerbose);
+                        else
+                            pNtkRes = Abc_NtkBalance(pNtk, fDuplicate, fSelective, fUpdateLevel);
+                    }
                     else
-                        pNtkRes = Abc_NtkBalance(pNtk, fDuplicate, fSelective, fUpdateLevel);
-                }
-                else
-                {
-                    pNtkTemp = Abc_NtkStrash(pNtk, 0, 0, 0);
-                    if (pNtkTemp == NULL)
                     {
-                        Abc_Print(-1, "Strashing before balancing has failed.\n");
+                        pNtkTemp = Abc_NtkStrash(pNtk, 0, 0, 0);
+                        if (pNtkTemp == NULL)
+                        {
+                            Abc_Print(-1, "Strashing before balancing has failed.\n");
+                            return;
+                        }
+                        if (fExor)
+                            pNtkRes = Abc_NtkBalanceExor(pNtkTemp, fUpdateLevel, fVerbose);
+                        else
+                            pNtkRes =
+                                Abc_NtkBalance(pNtkTemp, fDuplicate, fSelective, fUpdateLevel);
+                        Abc_NtkDelete(pNtkTemp);
+                    }
+                    // check if balancing worked
+                    if (pNtkRes == NULL)
+                    {
+                        Abc_Print(-1, "Balancing has failed.\n");
                         return;
                     }
-                    if (fExor)
-                        pNtkRes = Abc_NtkBalanceExor(pNtkTemp, fUpdateLevel, fVerbose);
-                    else
-                        pNtkRes =
-                            Abc_NtkBalance(pNtkTemp, fDuplicate, fSelective, fUpdateLevel);
-                    Abc_NtkDelete(pNtkTemp);
-                }
-                // check if balancing worked
-                if (pNtkRes == NULL)
-                {
-                    Abc_Print(-1, "Balancing has failed.\n");
-                    return;
-                }
-                // replace the current network
-                // Abc_FrameReplaceCurrentNetwork(pAbc, pNtkRes);
+                    // replace the current network
+                    // Abc_FrameReplaceCurrentNetwork(pAbc, pNtkRes);
 
-                store<pabc::Abc_Ntk_t *>().extend();
-                store<pabc::Abc_Ntk_t *>().current() = pNtkRes;
+                    MagicLS::memo_cache<pabc::Abc_Ntk_t *>::instance().insert(before, key, pNtkRes);
+                    extend_unique(store<pabc::Abc_Ntk_t *>(), pNtkRes);
+                }
             }
 
             end = clock();
@@ -67,16 +67,21 @@ namespace alice
                     Abc_Print(-1, "This command works only for strashed networks.\n");
                     return;
                 }
-                pNtkRes =
-                    Abc_NtkDC2(pNtk, fBalance, fUpdateLevel, fFanout, fPower, fVerbose);
-                if (pNtkRes == NULL)
+                const auto before = MagicLS::structural_hash(pNtk);
+                const auto key = MagicLS::memo_key("dc2", fBalance, fUpdateLevel, fFanout, fPower);
+                if (!extend_memoized(store<pabc::Abc_Ntk_t *>(), before, key))
                 {
-                    Abc_Print(-1, "Command has failed.\n");
-                    return;
+                    pNtkRes =
+                        Abc_NtkDC2(pNtk, fBalance, fUpdateLevel, fFanout, fPower, fVerbose);
+                    if (pNtkRes == NULL)
+                    {
+                        Abc_Print(-1, "Command has failed.\n");
+                        return;
+                    }
+
+                    MagicLS::memo_cache<pabc::Abc_Ntk_t *>::instance().insert(before, key, pNtkRes);
+                    extend_unique(store<pabc::Abc_Ntk_t *>(), pNtkRes);
                 }
-
-                store<pabc::Abc_Ntk_t *>().extend();
-                store<pabc::Abc_Ntk_t *>().current() = pNtkRes;
             }
 
             end = clock();
@@ -89,15 +89,22 @@ namespace alice
                     Abc_Print(-1, "This command works only for strashed networks.\n");
                     return;
                 }
-                pNtkRes = Abc_NtkDch(pNtk, pPars);
-                if (pNtkRes == NULL)
+                const auto before = MagicLS::structural_hash(pNtk);
+                const auto key = MagicLS::memo_key("dch", pPars->nWords, pPars->nBTLimit, pPars->nSatVarMax, pPars->fSynthesis, pPars->fPower,
+                                                   pPars->fSimulateTfo, pPars->fUseGia, pPars->fUseCSat, pPars->fLightSynth,
+                                                   pPars->fSkipRedSupp, pPars->fUseNew);
+                if (!extend_memoized(store<pabc::Abc_Ntk_t *>(), before, key))
                 {
-                    Abc_Print(-1, "Command has failed.\n");
-                    return;
-                }
+                    pNtkRes = Abc_NtkDch(pNtk, pPars);
+                    if (pNtkRes == NULL)
+                    {
+                        Abc_Print(-1, "Command has failed.\n");
+                        return;
+                    }
                 
-                store<pabc::Abc_Ntk_t *>().extend();
-                store<pabc::Abc_Ntk_t *>().current() = pNtkRes;
+                    MagicLS::memo_cache<pabc::Abc_Ntk_t *>::instance().insert(before, key, pNtkRes);
+                    extend_unique(store<pabc::Abc_Ntk_t *>(), pNtkRes);
+                }
             }
 
             end = clock();
@@ -0,0 +1,209 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file dch_map.hpp
+ *
+ * @brief  computes structural choices and maps with them in one step
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/21
+ */
+
+#ifndef DCH_MAP_HPP
+#define DCH_MAP_HPP
+
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "base/abc/abc.h"
+#include "base/main/main.h"
+
+#include "../../core/choice_map.hpp"
+#include "../../core/gia_lut.hpp"
+#include "../../core/library_manager.hpp"
+
+namespace alice
+{
+
+    class dch_map_command : public command
+    {
+    public:
+        explicit dch_map_command(const environment::ptr &env)
+            : command(env, "computes structural choices and maps the choice network directly")
+        {
+            add_option("-W, --words", nWords, "the max number of simulation words [default = 8]");
+            add_option("-C, --btlimit", nBTLimit, "the max number of conflicts at a node [default = 1000]");
+            add_option("-S, --satvarmax", nSatVarMax, "the max number of SAT variables [default = 5000]");
+            add_option("-K, --lut_size", lut_size, "map into K-input LUTs with '&if' instead of standard cells");
+            add_option("-P, --partitions", num_parts, "compute choices on this many output partitions, one after another [default = 1]");
+            add_flag("--lightsynth, -f", "toggle using faster logic synthesis [default = no]");
+            add_flag("--areaonly, -a", "toggles area-only standard cell mapping [default = no]");
+            add_flag("--verbose, -v", "toggle verbose printout [default = no]");
+        }
+
+    protected:
+        void execute()
+        {
+            clock_t begin = clock();
+
+            if (store<pabc::Abc_Ntk_t *>().size() == 0u)
+            {
+                std::cerr << "Error: Empty ABC AIG network\n";
+                return;
+            }
+            pabc::Abc_Ntk_t *pNtk = store<pabc::Abc_Ntk_t *>().current();
+            if (!pabc::Abc_NtkIsStrash(pNtk))
+            {
+                pabc::Abc_Print(-1, "This command works only for strashed networks.\n");
+                return;
+            }
+            if (num_parts > 1u && pabc::Abc_NtkLatchNum(pNtk) != 0)
+            {
+                pabc::Abc_Print(-1, "Partitioning works only for combinational networks.\n");
+                return;
+            }
+            const bool lut = is_set("lut_size");
+            if (!lut && pabc::Abc_FrameReadLibGen() == nullptr)
+            {
+                pabc::Abc_Print(-1, "The current library is not available, use abc_read_genlib first.\n");
+                return;
+            }
+
+            pabc::Dch_Pars_t pars;
+            pabc::Dch_ManSetDefaultParams(&pars);
+            pars.nWords = nWords;
+            pars.nBTLimit = nBTLimit;
+            pars.nSatVarMax = nSatVarMax;
+            if (is_set("lightsynth"))
+                pars.fLightSynth ^= 1;
+            pars.fVerbose = is_set("verbose");
+
+            /* one cone keeps the network as it is */
+            MagicLS::output_partition part;
+            if (num_parts > 1u)
+                part = MagicLS::partition_outputs(pNtk, num_parts);
+            else
+            {
+                part.cones.push_back(pNtk);
+                part.outputs.emplace_back();
+            }
+
+            auto choices = MagicLS::compute_choices(part.cones, pars);
+            bool failed = false;
+            for (auto *c : choices)
+                failed |= c == nullptr;
+            if (!failed)
+            {
+                uint32_t num_choices = 0u;
+                for (auto *c : choices)
+                    num_choices += pabc::Abc_NtkGetChoiceNum(c);
+                std::cout << fmt::format("[i] {} choice nodes in {} partition(s)\n", num_choices, choices.size());
+
+                if (lut)
+                    failed = !map_luts(pNtk, choices, part.outputs);
+                else
+                    failed = !map_cells(pNtk, choices, part.outputs);
+            }
+            if (failed)
+                pabc::Abc_Print(-1, "Command has failed.\n");
+
+            for (auto *c : choices)
+                if (c != nullptr)
+                    pabc::Abc_NtkDelete(c);
+            if (num_parts > 1u)
+                for (auto *c : part.cones)
+                    pabc::Abc_NtkDelete(c);
+
+            const double totalTime = (double)(clock() - begin) / CLOCKS_PER_SEC;
+            std::cout.setf(std::ios::fixed);
+            std::cout << "[CPU time]   " << std::setprecision(2) << totalTime << " s" << std::endl;
+        }
+
+    private:
+        /* Abc_NtkMap maps a choice network as it is, without strashing */
+        bool map_cells(pabc::Abc_Ntk_t *pNtk, std::vector<pabc::Abc_Ntk_t *> const &choices,
+                       std::vector<std::vector<int>> const &outputs)
+        {
+            const double DelayTarget = is_set("areaonly") ? 1000000000.0 : -1.0;
+            MagicLS::library_manager::instance().prepare_mapper(is_set("verbose"));
+
+            std::vector<pabc::Abc_Ntk_t *> mapped;
+            {
+                MagicLS::frame_library_sync sync;
+                for (auto *c : choices)
+                {
+                    auto *m = pabc::Abc_NtkMap(c, DelayTarget, 0, 0, 0, 0, 250, 0, 1, 0, 0, 0, 0, is_set("verbose"));
+                    if (m == nullptr)
+                        break;
+                    mapped.push_back(m);
+                }
+            }
+
+            if (mapped.size() != choices.size())
+            {
+                for (auto *m : mapped)
+                    pabc::Abc_NtkDelete(m);
+                return false;
+            }
+
+            pabc::Abc_Ntk_t *pNtkRes = mapped[0];
+            if (mapped.size() > 1u)
+            {
+                pNtkRes = MagicLS::stitch_mapped(pNtk, mapped, outputs);
+                for (auto *m : mapped)
+                    pabc::Abc_NtkDelete(m);
+            }
+            extend_unique(store<pabc::Abc_Ntk_t *>(), pNtkRes);
+            return true;
+        }
+
+        /* `&if` uses the choices carried by the GIA sibling pointers */
+        bool map_luts(pabc::Abc_Ntk_t *pNtk, std::vector<pabc::Abc_Ntk_t *> const &choices,
+                      std::vector<std::vector<int>> const &outputs)
+        {
+            pabc::Abc_Frame_t *abc = pabc::Abc_FrameGetGlobalFrame();
+            const auto script = fmt::format("&if -K {}", lut_size);
+
+            std::vector<mockturtle::klut_network> kluts;
+            pabc::Gia_Man_t *last = nullptr;
+            for (auto *c : choices)
+            {
+                pabc::Abc_FrameUpdateGia(abc, MagicLS::choices_to_gia(c));
+                if (pabc::Cmd_CommandExecute(abc, script.c_str()) != 0)
+                    return false;
+                /* owned by the frame, which stops it on a later update */
+                last = pabc::Abc_FrameGetGia(abc);
+                kluts.push_back(MagicLS::gia_to_klut(last));
+            }
+
+            /* a single partition also keeps a copy of the mapped GIA */
+            if (choices.size() == 1u)
+                extend_unique(store<pabc::Gia_Man_t *>(), pabc::Gia_ManDupWithAttributes(last));
+
+            auto klut = choices.size() == 1u
+                            ? kluts[0]
+                            : MagicLS::stitch_klut(pabc::Abc_NtkCiNum(pNtk), pabc::Abc_NtkCoNum(pNtk), kluts, outputs);
+            std::cout << fmt::format("[i] LUT-{} i/o = {}/{}   LUTs = {}\n", lut_size, klut.num_pis(), klut.num_pos(),
+                                     klut.num_gates());
+            store<mockturtle::klut_network>().extend();
+            store<mockturtle::klut_network>().current() = klut;
+            return true;
+        }
+
+    private:
+        int nWords = 8;
+        int nBTLimit = 1000;
+        int nSatVarMax = 5000;
+        uint32_t lut_size = 6u;
+        uint32_t num_parts = 1u;
+    };
+
+    ALICE_ADD_COMMAND(dch_map, "ABC")
+
+} // namespace alice
+
+#endif
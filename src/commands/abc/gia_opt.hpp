@@ -47,24 +47,30 @@ namespace alice
             else
             {
                 pabc::Gia_Man_t *gia_ntk = store<pabc::Gia_Man_t *>().current();
-                pabc::Gia_Man_t * gia = pabc::Gia_ManDup( gia_ntk );
-                pabc::Abc_Frame_t * abc = pabc::Abc_FrameGetGlobalFrame();
-                pabc::Abc_FrameUpdateGia(abc, gia);
-                const int success = pabc::Cmd_CommandExecute(abc, script.c_str());
-                if (success != 0) {
-                printf("syntax error in script\n");
+                const auto before = MagicLS::structural_hash(gia_ntk);
+                const auto key = MagicLS::memo_key("gia_opt", MagicLS::normalize_script(script));
+                if (!extend_memoized(store<pabc::Gia_Man_t *>(), before, key))
+                {
+                    pabc::Gia_Man_t * gia = pabc::Gia_ManDup( gia_ntk );
+                    pabc::Abc_Frame_t * abc = pabc::Abc_FrameGetGlobalFrame();
+                    pabc::Abc_FrameUpdateGia(abc, gia);
+                    const int success = pabc::Cmd_CommandExecute(abc, script.c_str());
+                    if (success != 0) {
+                    printf("syntax error in script\n");
+                    }
+                    pabc::Gia_Man_t * new_gia = pabc::Abc_FrameGetGia(abc);
+                    // fmt::print(" After Run ABC9 command: {} [GIA] PI/PO = {}/{}  nodes = {}  level = {}\n ", script, pabc::Gia_ManPiNum(new_gia), pabc::Gia_ManPoNum(new_gia), Gia_ManAndNum(new_gia), pabc::Gia_ManLevelNum(new_gia));
+                    fmt::print(" After Run ABC9 command: {} [GIA] PI/PO = {}/{}  nodes = {}  level = {}\n ",
+                        script, 
+                        pabc::Gia_ManPiNum(new_gia), 
+                        pabc::Gia_ManPoNum(new_gia), 
+                        Gia_ManAndNum(new_gia), 
+                        pabc::Gia_ManLevelNum(new_gia));
+
+                    MagicLS::memo_cache<pabc::Gia_Man_t *>::instance().insert(before, key, new_gia);
+                    /* the frame still owns new_gia and stops it on a later update */
+                    extend_unique(store<pabc::Gia_Man_t *>(), pabc::Gia_ManDupWithAttributes(new_gia));
                 }
-                pabc::Gia_Man_t * new_gia = pabc::Abc_FrameGetGia(abc);
-                // fmt::print(" After Run ABC9 command: {} [GIA] PI/PO = {}/{}  nodes = {}  level = {}\n ", script, pabc::Gia_ManPiNum(new_gia), pabc::Gia_ManPoNum(new_gia), Gia_ManAndNum(new_gia), pabc::Gia_ManLevelNum(new_gia));
-                fmt::print(" After Run ABC9 command: {} [GIA] PI/PO = {}/{}  nodes = {}  level = {}\n ",
-                    script, 
-                    pabc::Gia_ManPiNum(new_gia), 
-                    pabc::Gia_ManPoNum(new_gia), 
-                    Gia_ManAndNum(new_gia), 
-                    pabc::Gia_ManLevelNum(new_gia));
-
-                store<pabc::Gia_Man_t *>().extend();
-                store<pabc::Gia_Man_t *>().current() = new_gia;
             }
 
             end = clock();
@@ -71,18 +71,23 @@ namespace alice
                     return;
                 }
 
-                if (nPartSize > 0)
-                    pNtkRes = Abc_NtkDarFraigPart(pNtk, nPartSize, nConfLimit, nLevelMax, fVerbose);
-                else
-                    pNtkRes = Abc_NtkIvyFraig(pNtk, nConfLimit, fDoSparse, fProve, 0, fVerbose);
-                if (pNtkRes == NULL)
+                const auto before = MagicLS::structural_hash(pNtk);
+                const auto key = MagicLS::memo_key("ifraig", nPartSize, nConfLimit, nLevelMax, fDoSparse, fProve);
+                if (!extend_memoized(store<pabc::Abc_Ntk_t *>(), before, key))
                 {
-                    Abc_Print(-1, "Command has failed.\n");
-                    return;
+                    if (nPartSize > 0)
+                        pNtkRes = Abc_NtkDarFraigPart(pNtk, nPartSize, nConfLimit, nLevelMax, fVerbose);
+                    else
+                        pNtkRes = Abc_NtkIvyFraig(pNtk, nConfLimit, fDoSparse, fProve, 0, fVerbose);
+                    if (pNtkRes == NULL)
+                    {
+                        Abc_Print(-1, "Command has failed.\n");
+                        return;
+                    }
+
+                    MagicLS::memo_cache<pabc::Abc_Ntk_t *>::instance().insert(before, key, pNtkRes);
+                    extend_unique(store<pabc::Abc_Ntk_t *>(), pNtkRes);
                 }
-
-                store<pabc::Abc_Ntk_t *>().extend();
-                store<pabc::Abc_Ntk_t *>().current() = pNtkRes;
             }
 
             end = clock();
@@ -20,6 +20,8 @@
 #include "base/abci/abcMap.c"
 #include "base/abci/abcSweep.c"
 
+#include "../../core/library_manager.hpp"
+
 using namespace std;
 using namespace mockturtle;
 using namespace pabc;
@@ -88,53 +90,62 @@ namespace alice
                 }
                 if (fAreaOnly)
                     DelayTarget = ABC_INFINITY;
-                if (!Abc_NtkIsStrash(pNtk))
+                // supergates of the current library are derived once and reused
+                MagicLS::library_manager::instance().prepare_mapper(fVerbose);
+                const auto before = MagicLS::structural_hash(pNtk);
+                const auto key = MagicLS::memo_key("abc_map", library_hash(), DelayTarget, AreaMulti, DelayMulti, LogFan, Slew, Gain,
+                                                   nGatesMin, fRecovery, fSwitching, fSkipFanout, fUseProfile, fUseBuffs, fSweep);
+                if (!extend_memoized(store<pabc::Abc_Ntk_t *>(), before, key))
                 {
-                    pNtk = Abc_NtkStrash(pNtk, 0, 0, 0);
-                    if (pNtk == NULL)
-                    {
-                        Abc_Print(-1, "Strashing before mapping has failed.\n");
-                        return;
-                    }
-                    pNtk = Abc_NtkBalance(pNtkRes = pNtk, 0, 0, 1);
-                    Abc_NtkDelete(pNtkRes);
-                    if (pNtk == NULL)
-                    {
-                        Abc_Print(-1, "Balancing before mapping has failed.\n");
-                        return;
-                    }
-                    Abc_Print(0, "The network was strashed and balanced before mapping.\n");
-                    // get the new network
-                    pNtkRes = Abc_NtkMap(pNtk, DelayTarget, AreaMulti, DelayMulti, LogFan, Slew, Gain, nGatesMin, fRecovery, fSwitching, fSkipFanout, fUseProfile, fUseBuffs, fVerbose);
-                    if (pNtkRes == NULL)
+                    MagicLS::frame_library_sync sync;
+                    if (!Abc_NtkIsStrash(pNtk))
                     {
+                        pNtk = Abc_NtkStrash(pNtk, 0, 0, 0);
+                        if (pNtk == NULL)
+                        {
+                            Abc_Print(-1, "Strashing before mapping has failed.\n");
+                            return;
+                        }
+                        pNtk = Abc_NtkBalance(pNtkRes = pNtk, 0, 0, 1);
+                        Abc_NtkDelete(pNtkRes);
+                        if (pNtk == NULL)
+                        {
+                            Abc_Print(-1, "Balancing before mapping has failed.\n");
+                            return;
+                        }
+                        Abc_Print(0, "The network was strashed and balanced before mapping.\n");
+                        // get the new network
+                        pNtkRes = Abc_NtkMap(pNtk, DelayTarget, AreaMulti, DelayMulti, LogFan, Slew, Gain, nGatesMin, fRecovery, fSwitching, fSkipFanout, fUseProfile, fUseBuffs, fVerbose);
+                        if (pNtkRes == NULL)
+                        {
+                            Abc_NtkDelete(pNtk);
+                            Abc_Print(-1, "Mapping has failed.\n");
+                            return;
+                        }
                         Abc_NtkDelete(pNtk);
-                        Abc_Print(-1, "Mapping has failed.\n");
-                        return;
                     }
-                    Abc_NtkDelete(pNtk);
-                }
-                else
-                {
-                    // get the new network
-                    pNtkRes = Abc_NtkMap(pNtk, DelayTarget, AreaMulti, DelayMulti, LogFan, Slew, Gain, nGatesMin, fRecovery, fSwitching, fSkipFanout, fUseProfile, fUseBuffs, fVerbose);
-                    if (pNtkRes == NULL)
+                    else
                     {
-                        Abc_Print(-1, "Mapping has failed.\n");
-                        return;
+                        // get the new network
+                        pNtkRes = Abc_NtkMap(pNtk, DelayTarget, AreaMulti, DelayMulti, LogFan, Slew, Gain, nGatesMin, fRecovery, fSwitching, fSkipFanout, fUseProfile, fUseBuffs, fVerbose);
+                        if (pNtkRes == NULL)
+                        {
+                            Abc_Print(-1, "Mapping has failed.\n");
+                            return;
+                        }
                     }
-                }
-                if (fSweep)
-                {
-                    Abc_NtkFraigSweep(pNtkRes, 0, 0, 0, 0);
-                    if (Abc_NtkHasMapping(pNtkRes))
+                    if (fSweep)
                     {
-                        pNtkRes = Abc_NtkDupDfs(pNtk = pNtkRes);
-                        Abc_NtkDelete(pNtk);
+                        Abc_NtkFraigSweep(pNtkRes, 0, 0, 0, 0);
+                        if (Abc_NtkHasMapping(pNtkRes))
+                        {
+                            pNtkRes = Abc_NtkDupDfs(pNtk = pNtkRes);
+                            Abc_NtkDelete(pNtk);
+                        }
                     }
+                    MagicLS::memo_cache<pabc::Abc_Ntk_t *>::instance().insert(before, key, pNtkRes);
+                    extend_unique(store<pabc::Abc_Ntk_t *>(), pNtkRes);
                 }
-                store<pabc::Abc_Ntk_t *>().extend();
-                store<pabc::Abc_Ntk_t *>().current() = pNtkRes;
             }
 
             end = clock();
@@ -144,6 +155,14 @@ namespace alice
             cout << "[CPU time]   " << setprecision(2) << totalTime << " s" << endl;
         }
 
+    private:
+        /* mapping results depend on the library, so its hash is part of the memo key */
+        static uint64_t library_hash()
+        {
+            auto library = MagicLS::library_manager::instance().active();
+            return library ? library->hash : 0u;
+        }
+
     private:
         double DelayTarget = -1;
         double AreaMulti = 0;
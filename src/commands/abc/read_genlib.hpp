@@ -24,6 +24,8 @@
 #include "map/mio/mio.h"
 #include "misc/extra/extra.h"
 
+#include "../../core/library_manager.hpp"
+
 using namespace std;
 using namespace mockturtle;
 using namespace pabc;
@@ -55,48 +57,32 @@ namespace alice
             if (is_set("shortnames"))
                 fShortNames ^= 1;
 
-            pabc::Abc_Frame_t *pAbc;
-            pAbc = pabc::Abc_FrameGetGlobalFrame();
-
-            // set defaults
-            FILE *pFile;
-            pabc::Mio_Library_t *pLib;
-            pabc::Amap_Lib_t *pLib2;
-            char *pFileName;
-            char *pExcludeFile = NULL;
-
-            // get the input file name
-            pFileName = (char *)malloc(file_name.length() + 1);
-            if (pFileName != NULL)
+            // parse the library once, later reads of the same text reuse it
+            std::shared_ptr<MagicLS::library_entry> pLib;
+            try
             {
-                strcpy(pFileName, file_name.c_str());
+                pLib = MagicLS::library_manager::instance().load(file_name, fVerbose);
             }
-            else
-            {
-                printf("Memory allocation failed\n");
-            }
-
-            // set the new network
-            pLib = pabc::Mio_LibraryRead(pFileName, NULL, pExcludeFile, fVerbose);
-            if (pLib == NULL)
+            catch (std::exception const &e)
             {
-                printf("Reading genlib library has failed.\n");
+                printf("Reading genlib library has failed: %s\n", e.what());
                 return;
             }
             if (fVerbose)
-                printf("Entered genlib library with %d gates from file \"%s\".\n", Mio_LibraryReadGateNum(pLib), pFileName);
-
-            // prepare libraries
-            pabc::Mio_UpdateGenlib(pLib);
-
-            // replace the current library
-            pLib2 = pabc::Amap_LibReadAndPrepare(pFileName, NULL, 0, 0);
-            if (pLib2 == NULL)
+                printf("Entered genlib library with %d gates from file \"%s\".\n", Mio_LibraryReadGateNum(pLib->mio), file_name.c_str());
+            if (pLib->amap == NULL)
             {
                 printf("Reading second genlib library has failed.\n");
                 return;
             }
-            Abc_FrameSetLibGen2(pLib2);
+
+            // replace the current library
+            MagicLS::library_manager::instance().activate(pLib);
+
+            end = clock();
+            totalTime = (double)(end - begin) / CLOCKS_PER_SEC;
+            cout.setf(ios::fixed);
+            cout << "[CPU time]   " << setprecision(2) << totalTime << " s" << endl;
         }
 
     private:
@@ -96,28 +96,34 @@ namespace alice
                     return;
                 }
 
-                // modify the current network
-                pDup = Abc_NtkDup(pNtk);
-                RetValue = Abc_NtkRefactor(pNtk, nNodeSizeMax, nMinSaved, nConeSizeMax,
-                                           fUpdateLevel, fUseZeros, fUseDcs, fVerbose);
-                if (RetValue == -1)
+                const auto before = MagicLS::structural_hash(pNtk);
+                const auto key = MagicLS::memo_key("abc_refactor", nNodeSizeMax, nMinSaved, nConeSizeMax, fUpdateLevel, fUseZeros, fUseDcs);
+                if (!extend_memoized(store<pabc::Abc_Ntk_t *>(), before, key))
                 {
-                    // Abc_FrameReplaceCurrentNetwork(pAbc, pDup);
-                    printf(
-                        "An error occurred during computation. The original network is "
-                        "restored.\n");
-                }
-                else
-                {
-                    Abc_NtkDelete(pDup);
-                    if (RetValue == 0)
+                    // modify the current network
+                    pDup = Abc_NtkDup(pNtk);
+                    RetValue = Abc_NtkRefactor(pNtk, nNodeSizeMax, nMinSaved, nConeSizeMax,
+                                               fUpdateLevel, fUseZeros, fUseDcs, fVerbose);
+                    if (RetValue == -1)
+                    {
+                        // Abc_FrameReplaceCurrentNetwork(pAbc, pDup);
+                        printf(
+                            "An error occurred during computation. The original network is "
+                            "restored.\n");
+                    }
+                    else
                     {
-                        Abc_Print(0, "Refactoring has failed.\n");
-                        return;
+                        Abc_NtkDelete(pDup);
+                        if (RetValue == 0)
+                        {
+                            Abc_Print(0, "Refactoring has failed.\n");
+                            return;
+                        }
                     }
+                    if (RetValue == 1)
+                        MagicLS::memo_cache<pabc::Abc_Ntk_t *>::instance().insert(before, key, pNtk);
+                    extend_unique(store<pabc::Abc_Ntk_t *>(), pNtk, before);
                 }
-                store<pabc::Abc_Ntk_t *>().extend();
-                store<pabc::Abc_Ntk_t *>().current() = pNtk;
             }
 
             end = clock();
@@ -93,14 +93,19 @@ namespace alice
                     return;
                 }
 
-                // modify the current network
-                if (!Abc_NtkResubstitute(pNtk, nCutsMax, nNodesMax, nMinSaved, nLevelsOdc, fUpdateLevel, fVerbose, fVeryVerbose))
+                const auto before = MagicLS::structural_hash(pNtk);
+                const auto key = MagicLS::memo_key("abc_resub", nCutsMax, nNodesMax, nMinSaved, nLevelsOdc, fUpdateLevel);
+                if (!extend_memoized(store<pabc::Abc_Ntk_t *>(), before, key))
                 {
-                    Abc_Print(-1, "Refactoring has failed.\n");
-                    return;
+                    // modify the current network
+                    if (!Abc_NtkResubstitute(pNtk, nCutsMax, nNodesMax, nMinSaved, nLevelsOdc, fUpdateLevel, fVerbose, fVeryVerbose))
+                    {
+                        Abc_Print(-1, "Refactoring has failed.\n");
+                        return;
+                    }
+                    MagicLS::memo_cache<pabc::Abc_Ntk_t *>::instance().insert(before, key, pNtk);
+                    extend_unique(store<pabc::Abc_Ntk_t *>(), pNtk, before);
                 }
-                store<pabc::Abc_Ntk_t *>().extend();
-                store<pabc::Abc_Ntk_t *>().current() = pNtk;
             }
 
             end = clock();
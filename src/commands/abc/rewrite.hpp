@@ -74,25 +74,31 @@ namespace alice
                     return;
                 }
 
-                pDup = Abc_NtkDup(pNtk);
-                int RetValue = Abc_NtkRewrite(pNtk, fUpdateLevel, fUseZeros, fVerbose, fVeryVerbose, fPlaceEnable);
-                if (RetValue == -1)
+                const auto before = MagicLS::structural_hash(pNtk);
+                const auto key = MagicLS::memo_key("abc_rewrite", fUpdateLevel, fUseZeros, fPlaceEnable);
+                if (!extend_memoized(store<pabc::Abc_Ntk_t *>(), before, key))
                 {
-                    // TO DO
-                    //  Abc_FrameReplaceCurrentNetwork(pAbc, pDup);
-                    printf("An error occurred during computation. The original network is restored.\n");
-                }
-                else
-                {
-                    Abc_NtkDelete(pDup);
-                    if (RetValue == 0)
+                    pDup = Abc_NtkDup(pNtk);
+                    int RetValue = Abc_NtkRewrite(pNtk, fUpdateLevel, fUseZeros, fVerbose, fVeryVerbose, fPlaceEnable);
+                    if (RetValue == -1)
+                    {
+                        // TO DO
+                        //  Abc_FrameReplaceCurrentNetwork(pAbc, pDup);
+                        printf("An error occurred during computation. The original network is restored.\n");
+                    }
+                    else
                     {
-                        std::cerr << "Rewriting has failed.\n";
-                        return;
+                        Abc_NtkDelete(pDup);
+                        if (RetValue == 0)
+                        {
+                            std::cerr << "Rewriting has failed.\n";
+                            return;
+                        }
                     }
+                    if (RetValue == 1)
+                        MagicLS::memo_cache<pabc::Abc_Ntk_t *>::instance().insert(before, key, pNtk);
+                    extend_unique(store<pabc::Abc_Ntk_t *>(), pNtk, before);
                 }
-                store<pabc::Abc_Ntk_t *>().extend();
-                store<pabc::Abc_Ntk_t *>().current() = pNtk;
             }
 
             end = clock();
@@ -20,6 +20,7 @@
 #include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/io/write_verilog.hpp>
 #include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
 #include <mockturtle/networks/xmg.hpp>
 #include <mockturtle/algorithms/cleanup.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
@@ -50,8 +51,12 @@ namespace alice
             add_flag("--brent_kung_adder, -g", "create adder based on brent kung adder");
             add_flag("--kogge_stone_adder, -k", "create adder based on kogge stone adder");
             add_flag("--han_carlson_adder, -c", "create adder based on han carlson adder");
+            add_option("-n, --operands", operands, "create a multi-operand adder of n BIT-wide operands (compressor tree), --print_tt needs n x BIT <= 16");
+            add_option("-F, --final_adder", final_adder, "set the final adder of the multi-operand adder, set{brent-kung; kogge-stone; han-carlson;} [default = han-carlson]");
+            add_flag("--wallace, -w", "use only 3:2 compressors in the multi-operand adder tree [default = 4:2 and 3:2]");
 
-            add_flag("--xmg, -x", "Construct adder(BRS BLS) by XMG."); // TO DO
+            add_flag("--xmg, -x", "Construct adder(BRS, brent kung, kogge stone, han carlson) by XMG.");
+            add_flag("--mig, -m", "Construct adder(brent kung, kogge stone, han carlson) by MIG.");
             add_flag("--print_tt, -p", "print the network's output truth table (BIT <= 8).");
         }
 
@@ -60,7 +65,54 @@ namespace alice
         {
             if (is_set("bit"))
             {
-                if (is_set("carry_ripple_adder"))
+                if (is_set("operands"))
+                {
+                    if (operands < 2u)
+                    {
+                        std::cerr << "a multi-operand adder needs at least 2 operands" << std::endl;
+                        return;
+                    }
+                    auto func = prefix_adder_by_name<aig_network>(final_adder);
+                    if (func == nullptr)
+                    {
+                        std::cerr << "error: no " << final_adder << " function!" << std::endl;
+                        return;
+                    }
+                    std::cout << fmt::format("multi-operand adder: {} x {} bit, final adder: {}\n", operands, BIT, final_adder);
+                    aig_network aig;
+                    std::vector<std::vector<aig_network::signal>> ops(operands, std::vector<aig_network::signal>(BIT));
+                    for (auto &op : ops)
+                    {
+                        std::generate(op.begin(), op.end(), [&aig]()
+                                      { return aig.create_pi(); });
+                    }
+
+                    const auto sum = multi_operand_adder(aig, ops, func, !is_set("wallace"));
+                    for (const auto &out : sum)
+                    {
+                        aig.create_po(out);
+                    }
+
+                    /* a truth table per node, operands x BIT inputs */
+                    if (is_set("print_tt") && aig.num_pis() > 16u)
+                        std::cerr << "[w] " << aig.num_pis() << " inputs are too many to print truth tables (at most 16)" << std::endl;
+                    else if (is_set("print_tt"))
+                    {
+                        default_simulator<kitty::dynamic_truth_table> sim(aig.num_pis());
+                        const auto tts = simulate<kitty::dynamic_truth_table>(aig, sim);
+
+                        aig.foreach_po([&](auto const &, auto i)
+                                       { std::cout << fmt::format("truth table of output {} is {}\n", i, kitty::to_hex(tts[i])); });
+                    }
+
+                    aig = cleanup_dangling(aig);
+
+                    store<aig_network>().extend();
+                    store<aig_network>().current() = aig;
+
+                    MagicLS::print_stats(aig);
+                }
+                else if (is_set("carry_ripple_adder"))
                 {
                     std::cout << "carry_ripple_adder\n";
                     aig_network aig;
@@ -234,6 +286,18 @@ namespace alice
 
                     MagicLS::print_stats(aig);
                 }
+                else if ((is_set("brent_kung_adder") || is_set("kogge_stone_adder") || is_set("han_carlson_adder")) && (is_set("xmg") || is_set("mig")))
+                {
+                    const std::string name = is_set("brent_kung_adder") ? "brent-kung" : (is_set("kogge_stone_adder") ? "kogge-stone" : "han-carlson");
+                    if (is_set("xmg"))
+                    {
+                        majority_prefix_adder<xmg_network>(name);
+                    }
+                    else
+                    {
+                        majority_prefix_adder<mig_network>(name);
+                    }
+                }
                 else if (is_set("brent_kung_adder"))
                 {
                     std::cout << "brent_kung_adder\n";
@@ -394,8 +458,48 @@ namespace alice
             }
         }
 
+    private:
+        /* prefix adder built with MAJ-based prefix operators (and XOR3 sum bits for XMG) */
+        template <typename Ntk>
+        void majority_prefix_adder(std::string const &name)
+        {
+            std::cout << name << " adder (" << (std::is_same_v<Ntk, xmg_network> ? "XMG" : "MIG") << ")\n";
+            Ntk ntk;
+            std::vector<signal<Ntk>> a(BIT), b(BIT);
+            signal<Ntk> carry = ntk.get_constant(false);
+            std::generate(a.begin(), a.end(), [&ntk]()
+                          { return ntk.create_pi(); });
+            std::generate(b.begin(), b.end(), [&ntk]()
+                          { return ntk.create_pi(); });
+
+            prefix_adder_by_name<Ntk>(name)(ntk, a, b, carry);
+            for (const auto &out : a)
+            {
+                ntk.create_po(out);
+            }
+            ntk.create_po(carry);
+
+            if (is_set("print_tt"))
+            {
+                default_simulator<kitty::dynamic_truth_table> sim(ntk.num_pis());
+                const auto tts = simulate<kitty::dynamic_truth_table>(ntk, sim);
+
+                ntk.foreach_po([&](auto const &, auto i)
+                               { std::cout << fmt::format("truth table of output {} is {}\n", i, kitty::to_hex(tts[i])); });
+            }
+
+            ntk = cleanup_dangling(ntk);
+
+            store<Ntk>().extend();
+            store<Ntk>().current() = ntk;
+
+            MagicLS::print_stats(ntk);
+        }
+
     private:
         __uint32_t BIT = 0u;
+        __uint32_t operands = 0u;
+        std::string final_adder = "han-carlson";
     };
 
     ALICE_ADD_COMMAND(adder, "Generator")
@@ -0,0 +1,104 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file aiger.hpp
+ *
+ * @brief  fast binary AIGER reading and writing for the AIG store
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/12
+ */
+
+#ifndef AIGER_COMMAND_HPP
+#define AIGER_COMMAND_HPP
+
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <lorina/aiger.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+
+#include "../core/aiger_io.hpp"
+#include "../core/compressed_io.hpp"
+#include "../core/my_function.hpp"
+
+namespace alice
+{
+    class aiger_command : public command
+    {
+    public:
+        explicit aiger_command(const environment::ptr &env)
+            : command(env, "read or write binary AIGER, gzip/zstd compressed by extension")
+        {
+            add_option("-r, --read", read_file, "read an AIGER file into the AIG store");
+            add_option("-w, --write", write_file, "write the current AIG as binary AIGER");
+            add_flag("--no_strash, -n", "append the AND nodes without structural hashing when reading");
+        }
+
+    protected:
+        void execute()
+        {
+            clock_t begin = clock();
+
+            if (is_set("read"))
+            {
+                mockturtle::aig_network aig;
+                try
+                {
+                    if (!MagicLS::read_binary_aiger(read_file, aig, !is_set("no_strash")))
+                    {
+                        if (MagicLS::parse_file(read_file, [&](std::istream &in)
+                                                { return lorina::read_aiger(in, mockturtle::aiger_reader(aig)); }) != lorina::return_code::success)
+                        {
+                            std::cerr << "[e] parse error\n";
+                            return;
+                        }
+                    }
+                }
+                catch (std::exception const &e)
+                {
+                    std::cerr << "[e] " << e.what() << "\n";
+                    return;
+                }
+                store<mockturtle::aig_network>().extend();
+                store<mockturtle::aig_network>().current() = aig;
+                MagicLS::print_stats(aig);
+            }
+
+            if (is_set("write"))
+            {
+                if (store<mockturtle::aig_network>().size() == 0u)
+                {
+                    std::cerr << "Error: Empty AIG network\n";
+                    return;
+                }
+                try
+                {
+                    MagicLS::write_binary_aiger(store<mockturtle::aig_network>().current(), write_file);
+                }
+                catch (std::exception const &e)
+                {
+                    std::cerr << "[e] " << e.what() << "\n";
+                    return;
+                }
+            }
+
+            const double totalTime = (double)(clock() - begin) / CLOCKS_PER_SEC;
+            std::cout.setf(std::ios::fixed);
+            std::cout << "[CPU time]   " << std::setprecision(2) << totalTime << " s" << std::endl;
+        }
+
+    private:
+        std::string read_file;
+        std::string write_file;
+    };
+
+    ALICE_ADD_COMMAND(aiger, "I/O")
+
+} // namespace alice
+
+#endif
@@ -0,0 +1,56 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file balance.hpp
+ *
+ * @brief  SOP balancing
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/22
+ */
+
+#ifndef BALANCE_COMMAND_HPP
+#define BALANCE_COMMAND_HPP
+
+#include "./network_opt.hpp"
+
+namespace alice
+{
+    class balance_command : public network_opt_command<balance_command>
+    {
+    public:
+        explicit balance_command(const environment::ptr &env)
+            : network_opt_command(env, "SOP balancing of the current AIG, MIG, XAG or XMG")
+        {
+            add_option("--cut_size, -K", cut_size, "size of the rebalanced cuts [default = 4]");
+            add_flag("--critical, -c", "only rebalance nodes on the critical path [default = no]");
+        }
+
+        template <class Ntk>
+        static constexpr bool supports = true;
+
+        template <class Ntk>
+        Ntk optimize(Ntk const &ntk)
+        {
+            mockturtle::balancing_params ps;
+            ps.cut_enumeration_ps.cut_size = cut_size;
+            ps.only_on_critical_path = is_set("critical");
+            ps.verbose = is_set("verbose");
+
+            mockturtle::balancing_stats st;
+            Ntk res = MagicLS::sop_balance(ntk, ps, &st);
+            if (is_set("verbose"))
+                st.report();
+            return res;
+        }
+
+    private:
+        uint32_t cut_size = 4u;
+    };
+
+    ALICE_ADD_COMMAND(balance, "Synthesis")
+
+} // namespace alice
+
+#endif
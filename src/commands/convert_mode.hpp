@@ -0,0 +1,72 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file convert_mode.hpp
+ *
+ * @brief  select how the AIG, MIG, XAG and XMG stores are converted
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/02
+ */
+
+#ifndef CONVERT_MODE_HPP
+#define CONVERT_MODE_HPP
+
+#include <iostream>
+
+#include "../core/convert.hpp"
+
+namespace alice
+{
+    class convert_mode_command : public command
+    {
+    public:
+        explicit convert_mode_command(const environment::ptr &env)
+            : command(env, "select the store conversion mode used by `convert`")
+        {
+            add_flag("--fast, -f", "convert gate for gate in one linear pass");
+            add_flag("--resyn, -r", "convert by LUT mapping and node resynthesis");
+            add_option("-k, --cut_size", cut_size, "set the cut size of the resynthesis mode, the NPN databases use at most 4 [default = 4]");
+        }
+
+    protected:
+        void execute()
+        {
+            auto &ps = MagicLS::convert_ps();
+            if (is_set("fast") && is_set("resyn"))
+            {
+                std::cerr << "[e] --fast and --resyn are exclusive\n";
+                return;
+            }
+            if (is_set("fast"))
+            {
+                ps.fast = true;
+            }
+            if (is_set("resyn"))
+            {
+                ps.fast = false;
+            }
+            if (is_set("cut_size"))
+            {
+                if (cut_size < 2u)
+                {
+                    std::cerr << "[e] cut size must be at least 2\n";
+                    return;
+                }
+                ps.cut_size = cut_size;
+            }
+
+            std::cout << fmt::format("[i] convert mode = {}   cut size = {} (NPN databases: {})\n",
+                                     ps.fast ? "fast" : "resyn", ps.cut_size, MagicLS::npn_cut_size());
+        }
+
+    private:
+        uint32_t cut_size = 4u;
+    };
+
+    ALICE_ADD_COMMAND(convert_mode, "General")
+
+} // namespace alice
+
+#endif
@@ -0,0 +1,64 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file depth_rewrite.hpp
+ *
+ * @brief  algebraic depth rewriting of MIGs
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/22
+ */
+
+#ifndef DEPTH_REWRITE_COMMAND_HPP
+#define DEPTH_REWRITE_COMMAND_HPP
+
+#include <type_traits>
+
+#include "./network_opt.hpp"
+
+namespace alice
+{
+    class depth_rewrite_command : public network_opt_command<depth_rewrite_command>
+    {
+    public:
+        explicit depth_rewrite_command(const environment::ptr &env)
+            : network_opt_command(env, "algebraic depth rewriting of the current MIG (use -m)")
+        {
+            add_option("--strategy, -s", strategy, "0: dfs, 1: aggressive, 2: selective [default = 0]");
+            add_option("--overhead, -o", overhead, "allowed size overhead of the selective strategy [default = 2.0]");
+            add_flag("--no_area, -a", "do not allow the size to increase [default = no]");
+        }
+
+        template <class Ntk>
+        static constexpr bool supports = std::is_same_v<Ntk, mockturtle::mig_network>;
+
+        template <class Ntk>
+        Ntk optimize(Ntk const &ntk)
+        {
+            using params_t = mockturtle::mig_algebraic_depth_rewriting_params;
+            params_t ps;
+            ps.strategy = strategy == 1u   ? params_t::aggressive
+                          : strategy == 2u ? params_t::selective
+                                           : params_t::dfs;
+            ps.overhead = overhead;
+            ps.allow_area_increase = !is_set("no_area");
+            ps.verbose = is_set("verbose");
+
+            mockturtle::mig_algebraic_depth_rewriting_stats st;
+            Ntk res = MagicLS::depth_rewrite(ntk, ps, &st);
+            if (is_set("verbose"))
+                st.report();
+            return res;
+        }
+
+    private:
+        uint32_t strategy = 0u;
+        double overhead = 2.0;
+    };
+
+    ALICE_ADD_COMMAND(depth_rewrite, "Synthesis")
+
+} // namespace alice
+
+#endif
@@ -0,0 +1,140 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file exact.hpp
+ *
+ * @brief  compute size-optimal networks for the entries of the opt store
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/27
+ */
+
+#ifndef EXACT_COMMAND_HPP
+#define EXACT_COMMAND_HPP
+
+#include <chrono>
+#include <ctime>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <vector>
+
+#include "../core/exact_synthesis.hpp"
+#include "../core/thread_pool.hpp"
+
+namespace alice
+{
+    class exact_command : public command
+    {
+    public:
+        explicit exact_command(const environment::ptr &env)
+            : command(env, "SAT-based exact synthesis of the functions in the opt store")
+        {
+            add_flag("--mig, -m", "synthesize MIGs");
+            add_flag("--xag, -x", "synthesize XAGs");
+            add_flag("--xmg, -g", "synthesize XMGs");
+            add_flag("--current, -c", "process only the current entry");
+            add_flag("--force, -f", "recompute entries with a network");
+            add_option("--gates, -G", max_gates, "maximum number of gates [default = 12]");
+            add_option("--conflicts, -C", conflict_limit, "conflict limit per SAT call, 0 for none [default = 0]");
+            add_option("--threads, -j", num_threads, "number of worker threads [default = all cores]");
+            add_flag("--verbose, -v", "print the network of every entry");
+        }
+
+    protected:
+        void execute()
+        {
+            clock_t begin = clock();
+            const auto wall_begin = std::chrono::steady_clock::now();
+
+            auto &opts = store<optimum_network>();
+            if (opts.empty())
+            {
+                std::cerr << "Error: Empty opt store\n";
+                return;
+            }
+
+            const auto basis = is_set("mig")   ? MagicLS::exact_basis::mig
+                               : is_set("xag") ? MagicLS::exact_basis::xag
+                               : is_set("xmg") ? MagicLS::exact_basis::xmg
+                                               : MagicLS::exact_basis::aig;
+            MagicLS::exact_synthesis_params ps;
+            ps.max_gates = max_gates;
+            ps.conflict_limit = conflict_limit;
+
+            std::vector<optimum_network *> entries;
+            if (is_set("current"))
+            {
+                entries.push_back(&opts.current());
+            }
+            else
+            {
+                for (auto i = 0u; i < opts.size(); ++i)
+                    entries.push_back(&opts[i]);
+            }
+
+            /* the entries of one NPN class wait for the first of them */
+            MagicLS::thread_pool pool(num_threads);
+            std::vector<std::future<std::optional<MagicLS::exact_chain>>> results;
+            for (auto *entry : entries)
+            {
+                if (!entry->network.empty() && !is_set("force"))
+                {
+                    results.emplace_back();
+                    continue;
+                }
+                results.push_back(pool.submit([entry, basis, ps]() {
+                    return MagicLS::exact_synthesize_cached(entry->function, basis, ps);
+                }));
+            }
+
+            auto solved = 0u, skipped = 0u, failed = 0u;
+            for (auto i = 0u; i < entries.size(); ++i)
+            {
+                if (!results[i].valid())
+                {
+                    ++skipped;
+                    continue;
+                }
+                const auto chain = results[i].get();
+                if (!chain || MagicLS::simulate_chain(*chain) != entries[i]->function)
+                {
+                    ++failed;
+                    std::cout << fmt::format("[w] no network for {}\n", kitty::to_hex(entries[i]->function));
+                    continue;
+                }
+                ++solved;
+                entries[i]->network = MagicLS::chain_to_expression(*chain);
+                if (is_set("verbose"))
+                {
+                    std::cout << fmt::format("[i] {}: {} gates, {}\n", kitty::to_hex(entries[i]->function),
+                                             chain->gates.size(), entries[i]->network);
+                }
+            }
+
+            auto const &cache = MagicLS::exact_npn_cache::instance();
+            std::cout << fmt::format("[i] solved = {}   skipped = {}   failed = {}   threads = {}\n", solved, skipped,
+                                     failed, pool.size());
+            std::cout << fmt::format("[i] NPN cache: classes = {}   hits = {}   misses = {}\n", cache.size(),
+                                     cache.hits(), cache.misses());
+
+            const double totalTime = (double)(clock() - begin) / CLOCKS_PER_SEC;
+            const std::chrono::duration<double> wall = std::chrono::steady_clock::now() - wall_begin;
+            std::cout.setf(std::ios::fixed);
+            std::cout << "[CPU time]   " << std::setprecision(2) << totalTime << " s" << std::endl;
+            std::cout << "[Wall time]  " << std::setprecision(2) << wall.count() << " s" << std::endl;
+        }
+
+    private:
+        uint32_t max_gates = 12u;
+        uint32_t conflict_limit = 0u;
+        uint32_t num_threads = 0u;
+    };
+
+    ALICE_ADD_COMMAND(exact, "Synthesis")
+
+} // namespace alice
+
+#endif
@@ -0,0 +1,66 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file exact_cache.hpp
+ *
+ * @brief  manage the NPN-keyed exact synthesis cache
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/04
+ */
+
+#ifndef EXACT_CACHE_COMMAND_HPP
+#define EXACT_CACHE_COMMAND_HPP
+
+#include <iostream>
+#include <string>
+
+#include "../core/exact_cache.hpp"
+
+namespace alice
+{
+    class exact_cache_command : public command
+    {
+    public:
+        explicit exact_cache_command(const environment::ptr &env)
+            : command(env, "manage the exact synthesis cache used by the xmg to aig conversion")
+        {
+            add_option("-l, --load", load_file, "merge the cache entries of a binary cache file");
+            add_option("-s, --save", save_file, "write the cache into a binary cache file");
+            add_flag("--clear, -c", "remove all cache entries");
+        }
+
+    protected:
+        void execute()
+        {
+            auto &cache = MagicLS::exact_cache::instance();
+            if (is_set("clear"))
+            {
+                cache.clear();
+            }
+            if (is_set("load") && !cache.load(load_file))
+            {
+                std::cerr << "[e] could not load the exact cache from " << load_file << "\n";
+                return;
+            }
+            if (is_set("save") && !cache.save(save_file))
+            {
+                std::cerr << "[e] could not save the exact cache to " << save_file << "\n";
+                return;
+            }
+
+            std::cout << fmt::format("[i] exact cache: entries = {}   hits = {}   misses = {}\n",
+                                     cache.size(), cache.hits(), cache.misses());
+        }
+
+    private:
+        std::string load_file;
+        std::string save_file;
+    };
+
+    ALICE_ADD_COMMAND(exact_cache, "General")
+
+} // namespace alice
+
+#endif
@@ -0,0 +1,83 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file exact_resyn.hpp
+ *
+ * @brief  exact resynthesis of small windows
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/28
+ */
+
+#ifndef EXACT_RESYN_COMMAND_HPP
+#define EXACT_RESYN_COMMAND_HPP
+
+#include <type_traits>
+
+#include "../core/exact_resyn.hpp"
+#include "../core/thread_pool.hpp"
+#include "./network_opt.hpp"
+
+namespace alice
+{
+    class exact_resyn_command : public network_opt_command<exact_resyn_command>
+    {
+    public:
+        explicit exact_resyn_command(const environment::ptr &env)
+            : network_opt_command(env, "replace small windows of the current AIG or XAG by size-optimal ones")
+        {
+            add_option("--cut_size, -K", cut_size, "maximum number of inputs of a window, 2 to 6 [default = 6]");
+            add_option("--gates, -G", max_gates, "maximum number of gates of a replacement [default = 7]");
+            add_option("--conflicts, -C", conflict_limit, "conflict limit per SAT call, 0 for none [default = 10000]");
+            add_option("--threads, -j", num_threads, "number of worker threads [default = all cores]");
+        }
+
+    protected:
+        /* the SAT encoding grows with 2^K minterms per gate */
+        void execute()
+        {
+            if (cut_size < 2u || cut_size > 6u)
+            {
+                std::cerr << "Error: the cut size must be between 2 and 6\n";
+                return;
+            }
+            network_opt_command::execute();
+        }
+
+    public:
+        template <class Ntk>
+        static constexpr bool supports =
+            std::is_same_v<Ntk, mockturtle::aig_network> || std::is_same_v<Ntk, mockturtle::xag_network>;
+
+        template <class Ntk>
+        Ntk optimize(Ntk const &ntk)
+        {
+            MagicLS::exact_resyn_params ps;
+            ps.cut_size = cut_size;
+            ps.synthesis.max_gates = max_gates;
+            ps.synthesis.conflict_limit = conflict_limit;
+
+            MagicLS::thread_pool pool(num_threads);
+            MagicLS::exact_resyn_stats st;
+            Ntk res = MagicLS::exact_resynthesize(ntk, ps, pool, &st);
+            if (is_set("verbose"))
+            {
+                std::cout << fmt::format("[i] windows = {}   replaced = {}   kept = {}   gain = {}   threads = {}\n",
+                                         st.windows, st.replaced, st.kept, st.gain, pool.size());
+            }
+            return res;
+        }
+
+    private:
+        uint32_t cut_size = 6u;
+        uint32_t max_gates = 7u;
+        uint32_t conflict_limit = 10000u;
+        uint32_t num_threads = 0u;
+    };
+
+    ALICE_ADD_COMMAND(exact_resyn, "Synthesis")
+
+} // namespace alice
+
+#endif
@@ -0,0 +1,112 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file explore.hpp
+ *
+ * @brief  search for the best optimization script of the current AIG
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/25
+ */
+
+#ifndef EXPLORE_COMMAND_HPP
+#define EXPLORE_COMMAND_HPP
+
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "../core/explore.hpp"
+
+namespace alice
+{
+    class explore_command : public command
+    {
+    public:
+        explicit explore_command(const environment::ptr &env)
+            : command(env, "search sequences of ABC and mockturtle transforms for the best result on the current AIG")
+        {
+            add_option("--strategy, -s", strategy, "beam, random or bandit [default = beam]");
+            add_option("--metric, -m", metric, "cost to minimize: lut (LUT-6 count), level or gates [default = lut]");
+            add_option("--width, -W", ps.beam_width, "candidates kept per beam step [default = 4]");
+            add_option("--depth, -D", ps.depth, "maximum script length of beam and random search [default = 6]");
+            add_option("--restarts, -R", ps.restarts, "scripts tried by random search [default = 16]");
+            add_option("--rounds, -N", ps.rounds, "rounds of the bandit [default = 16]");
+            add_option("--threads, -j", ps.num_threads, "number of worker threads [default = all cores]");
+            add_option("--time, -T", ps.time_budget, "wall time budget in seconds, 0 for none [default = 60]");
+            add_option("--memory, -M", ps.memory_budget_mb, "resident memory budget in MiB, 0 for none [default = 0]");
+            add_option("--seed, -S", ps.seed, "seed of random search [default = 1]");
+            add_flag("--verbose, -v", "print every improvement [default = no]");
+        }
+
+    protected:
+        void execute()
+        {
+            clock_t begin = clock();
+            const auto wall_begin = std::chrono::steady_clock::now();
+
+            if (store<mockturtle::aig_network>().size() == 0u)
+            {
+                std::cerr << "Error: Empty AIG network\n";
+                return;
+            }
+            if (strategy == "beam")
+                ps.strategy = MagicLS::explore_strategy::beam;
+            else if (strategy == "random")
+                ps.strategy = MagicLS::explore_strategy::random;
+            else if (strategy == "bandit")
+                ps.strategy = MagicLS::explore_strategy::bandit;
+            else
+            {
+                std::cerr << "Error: unknown strategy " << strategy << "\n";
+                return;
+            }
+            if (metric == "lut")
+                ps.metric = MagicLS::explore_metric::luts;
+            else if (metric == "level")
+                ps.metric = MagicLS::explore_metric::levels;
+            else if (metric == "gates")
+                ps.metric = MagicLS::explore_metric::gates;
+            else
+            {
+                std::cerr << "Error: unknown metric " << metric << "\n";
+                return;
+            }
+            ps.verbose = is_set("verbose");
+
+            auto const &aig = store<mockturtle::aig_network>().current();
+            const auto before = MagicLS::structural_hash(aig);
+            MagicLS::explorer search(ps, MagicLS::default_transforms());
+            const auto res = search.run(aig);
+
+            std::string script;
+            for (auto const &step : res.script)
+                script += (script.empty() ? "" : "; ") + step;
+            std::cout << fmt::format("[i] evaluated {} candidates{}\n", res.evaluated,
+                                     res.budget_exhausted ? ", budget exhausted" : "");
+            std::cout << fmt::format("[i] {} = ({}, {}) -> ({}, {})\n", metric, res.initial_cost.first,
+                                     res.initial_cost.second, res.cost.first, res.cost.second);
+            std::cout << "[i] best script: " << (script.empty() ? "(none)" : script) << "\n";
+            extend_unique(store<mockturtle::aig_network>(), res.network, before);
+
+            const double totalTime = (double)(clock() - begin) / CLOCKS_PER_SEC;
+            const std::chrono::duration<double> wall = std::chrono::steady_clock::now() - wall_begin;
+            std::cout.setf(std::ios::fixed);
+            std::cout << "[CPU time]   " << std::setprecision(2) << totalTime << " s" << std::endl;
+            std::cout << "[Wall time]  " << std::setprecision(2) << wall.count() << " s" << std::endl;
+        }
+
+    private:
+        MagicLS::explore_params ps;
+        std::string strategy = "beam";
+        std::string metric = "lut";
+    };
+
+    ALICE_ADD_COMMAND(explore, "Synthesis")
+
+} // namespace alice
+
+#endif
@@ -13,6 +13,10 @@
 #ifndef EXPRSIM_HPP
 #define EXPRSIM_HPP
 
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/views/depth_view.hpp>
+
+#include "../core/expression.hpp"
 #include "../store.hpp"
 
 namespace alice
@@ -28,11 +32,24 @@ namespace alice
       add_option("-e,--expression", expression, "creates truth table from expression");
       add_flag("-n,--new", "adds new store entry");
       add_option("-m,--max_num_vars", max_num_vars, "set the maximum number of variables");
+      add_flag("-a,--aig", "compile an expression over named variables into the AIG store");
+      add_flag("-x,--xag", "compile an expression over named variables into the XAG store");
+      add_flag("-t,--truth_table", "with -a or -x, also add the truth table to the opt store (at most 16 inputs)");
+      add_option("-p,--patterns", num_words, "with -a or -x, simulate 64 x this many random patterns");
     }
 
   protected:
     void execute()
     {
+      if (is_set("aig") || is_set("xag"))
+      {
+        if (is_set("xag"))
+          compile<mockturtle::xag_network>("XAG");
+        else
+          compile<mockturtle::aig_network>("AIG");
+        return;
+      }
+
       auto &opt_ntks = store<optimum_network>();
 
       if (opt_ntks.empty() || is_set("new"))
@@ -72,8 +89,72 @@ namespace alice
     }
 
   private:
+    /* Expressions such as "sel & (a[0] ^ b[0]) | !sel & maj(x, y, z)" are
+     * built gate by gate; the truth table is only materialized with -t,
+     * by simulating the network. */
+    template <class Ntk>
+    void compile(const char *name)
+    {
+      MagicLS::expression_compiler<Ntk> compiler(expression);
+      Ntk ntk;
+      try
+      {
+        ntk = compiler.compile();
+      }
+      catch (std::invalid_argument const &e)
+      {
+        std::cerr << "[e] " << e.what() << "\n";
+        return;
+      }
+
+      std::cout << fmt::format("[i] {}   inputs = {}   gates = {}   level = {}\n", name, ntk.num_pis(),
+                               ntk.num_gates(), mockturtle::depth_view(ntk).depth());
+      if (is_set("verbose"))
+      {
+        std::cout << "[i] inputs:";
+        for (auto const &input : compiler.inputs())
+          std::cout << " " << input;
+        std::cout << "\n";
+      }
+
+      if (num_words > 0u)
+      {
+        const auto words = MagicLS::simulate_random_words(ntk, num_words);
+        uint64_t ones = 0u;
+        for (auto w : words)
+          ones += __builtin_popcountll(w);
+        std::cout << fmt::format("[i] {} random patterns   ones = {}   signature = {:016x}\n", 64u * num_words,
+                                 ones, words.front());
+      }
+
+      if (is_set("truth_table"))
+      {
+        if (ntk.num_pis() > max_truth_table_vars)
+        {
+          std::cerr << fmt::format("[e] {} inputs are too many for a truth table\n", ntk.num_pis());
+        }
+        else
+        {
+          mockturtle::default_simulator<kitty::dynamic_truth_table> sim(ntk.num_pis());
+          optimum_network opt(mockturtle::simulate<kitty::dynamic_truth_table>(ntk, sim)[0]);
+          opt.network = expression;
+          std::cout << fmt::format("tt: 0x{}", kitty::to_hex(opt.function)) << std::endl;
+          store<optimum_network>().extend();
+          store<optimum_network>().current() = opt;
+        }
+      }
+
+      store<Ntk>().extend();
+      store<Ntk>().current() = ntk;
+    }
+
+  private:
+    /* the simulation keeps a truth table per node, 8 KiB each at 16 inputs */
+    static constexpr uint32_t max_truth_table_vars = 16u;
+
     std::string expression = "";
     uint32_t max_num_vars = 0u;
+    uint32_t num_words = 0u;
   };
 
   ALICE_ADD_COMMAND(exprsim, "Loading")
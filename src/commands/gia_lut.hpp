@@ -0,0 +1,86 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file gia_lut.hpp
+ *
+ * @brief  move the LUT mapping of the current GIA into the LUT store
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/20
+ */
+
+#ifndef GIA_LUT_COMMAND_HPP
+#define GIA_LUT_COMMAND_HPP
+
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/views/depth_view.hpp>
+
+#include "../core/gia_lut.hpp"
+
+namespace alice
+{
+    class gia_lut_command : public command
+    {
+    public:
+        explicit gia_lut_command(const environment::ptr &env)
+            : command(env, "copy the LUT mapping of the current GIA into the LUT store")
+        {
+            add_option("--lut_size, -K", lut_size, "map the GIA with '&if -K <lut_size>' first");
+        }
+
+    protected:
+        void execute()
+        {
+            clock_t begin = clock();
+
+            if (store<pabc::Gia_Man_t *>().size() == 0u)
+            {
+                std::cerr << "Empty GIA\n";
+                return;
+            }
+
+            pabc::Gia_Man_t *gia = store<pabc::Gia_Man_t *>().current();
+            if (is_set("lut_size"))
+            {
+                pabc::Abc_Frame_t *abc = pabc::Abc_FrameGetGlobalFrame();
+                pabc::Abc_FrameUpdateGia(abc, pabc::Gia_ManDup(gia));
+                const auto script = fmt::format("&if -K {}", lut_size);
+                if (pabc::Cmd_CommandExecute(abc, script.c_str()) != 0)
+                {
+                    std::cerr << "Error: " << script << " has failed\n";
+                    return;
+                }
+                /* the frame keeps its GIA, the store gets a copy with the mapping */
+                extend_unique(store<pabc::Gia_Man_t *>(), pabc::Gia_ManDupWithAttributes(pabc::Abc_FrameGetGia(abc)));
+                gia = store<pabc::Gia_Man_t *>().current();
+            }
+            if (!pabc::Gia_ManHasMapping(gia))
+                std::cout << "[w] the GIA has no LUT mapping, every AND becomes a 2-input LUT\n";
+
+            const auto klut = MagicLS::gia_to_klut(gia);
+            mockturtle::depth_view depth{klut};
+            std::cout << fmt::format("[i] LUTs i/o = {}/{}   LUTs = {}   level = {}\n", klut.num_pis(), klut.num_pos(),
+                                     klut.num_gates(), depth.depth());
+            store<mockturtle::klut_network>().extend();
+            store<mockturtle::klut_network>().current() = klut;
+
+            const double totalTime = (double)(clock() - begin) / CLOCKS_PER_SEC;
+            std::cout.setf(std::ios::fixed);
+            std::cout << "[CPU time]   " << std::setprecision(2) << totalTime << " s" << std::endl;
+        }
+
+    private:
+        uint32_t lut_size = 6u;
+    };
+
+    ALICE_ADD_COMMAND(gia_lut, "ABC")
+
+} // namespace alice
+
+#endif
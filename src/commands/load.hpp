@@ -35,14 +35,35 @@
 #ifndef LOAD_HPP
 #define LOAD_HPP
 
+#include <chrono>
+#include <ctime>
+#include <future>
+#include <iomanip>
+#include <optional>
+#include <vector>
+
+#include "../core/mapped_file.hpp"
+#include "../core/thread_pool.hpp"
+#include "../core/truth_table_io.hpp"
 #include "../store.hpp"
 
 namespace alice {
 
+/* the npn variable selects the canonizer, other non-empty values mean
+ * exact canonization as before */
+std::optional<MagicLS::npn_canonizer> npn_canonizer_of(command &cmd) {
+  const auto method = cmd.env->variable("npn");
+  if (method == "") {
+    return std::nullopt;
+  }
+  return MagicLS::npn_canonizer_from_string(method).value_or(
+      MagicLS::npn_canonizer::exact);
+}
+
 void add_optimum_network_entry(command &cmd,
                                kitty::dynamic_truth_table &function) {
-  if (cmd.env->variable("npn") != "") {
-    function = std::get<0>(kitty::exact_npn_canonization(function));
+  if (const auto method = npn_canonizer_of(cmd)) {
+    function = MagicLS::npn_canonize(function, *method);
   }
 
   optimum_network entry(function);
@@ -59,10 +80,28 @@ class load_command : public command {
     add_option("truth_table,--tt", truth_table, "truth table in hex format");
     add_flag("--binary,-b", "read truth table as binary string");
     add_option("--majn,-m", odd_inputs, "generate majority-of-n truth table ");
+    add_flag("--clear,-c", "forget the functions loaded so far before loading");
+    add_option("--file,-f", filename,
+               "load all truth tables of a text file (hex, or binary with -b) "
+               "or a packed binary file");
+    add_option("--threads,-j", num_threads,
+               "number of worker threads for -f [default = all cores]");
   }
 
  protected:
   void execute() override {
+    if (is_set("clear")) {
+      MagicLS::function_index::instance().clear();
+      if (truth_table.empty() && !is_set("majn") && !is_set("file")) {
+        return;
+      }
+    }
+
+    if (is_set("file")) {
+      load_file();
+      return;
+    }
+
     auto function = [this]() {
       if (is_set("binary")) {
         const unsigned num_vars = ::log(truth_table.size()) / ::log(2.0);
@@ -91,9 +130,93 @@ class load_command : public command {
     add_optimum_network_entry(*this, function);
   }
 
+ private:
+  /* Parses and canonizes in chunks on a thread pool; deduplication and
+   * insertion follow the file order, so the store does not depend on the
+   * scheduling. */
+  void load_file() {
+    clock_t begin = clock();
+    const auto wall_begin = std::chrono::steady_clock::now();
+
+    std::optional<MagicLS::mapped_file> file;
+    try {
+      file.emplace(filename);
+    } catch (std::exception const &e) {
+      std::cerr << "[e] " << e.what() << "\n";
+      return;
+    }
+
+    std::vector<std::optional<kitty::dynamic_truth_table>> functions;
+    std::vector<std::string_view> lines;
+    if (MagicLS::is_packed_truth_tables(file->data(), file->size())) {
+      auto tts = MagicLS::read_packed_truth_tables(file->data(), file->size());
+      if (!tts) {
+        std::cerr << "[e] invalid packed truth table file " << filename << "\n";
+        return;
+      }
+      functions.assign(std::make_move_iterator(tts->begin()),
+                       std::make_move_iterator(tts->end()));
+    } else {
+      lines = MagicLS::truth_table_lines(file->data(), file->size());
+      functions.resize(lines.size());
+    }
+
+    const auto method = npn_canonizer_of(*this);
+    const bool binary = is_set("binary");
+    MagicLS::thread_pool pool(num_threads);
+    const std::size_t chunk = 4096u;
+    std::vector<std::future<void>> tasks;
+    for (std::size_t first = 0u; first < functions.size(); first += chunk) {
+      tasks.push_back(pool.submit([&, first]() {
+        const auto last = std::min(first + chunk, functions.size());
+        for (auto i = first; i < last; ++i) {
+          if (!lines.empty()) {
+            functions[i] = MagicLS::parse_truth_table(lines[i], binary);
+          }
+          if (functions[i] && method) {
+            functions[i] = MagicLS::npn_canonize(*functions[i], *method);
+          }
+        }
+      }));
+    }
+    for (auto &t : tasks) {
+      t.get();
+    }
+
+    auto &index = MagicLS::function_index::instance();
+    auto &opts = store<optimum_network>();
+    uint64_t added = 0u, duplicates = 0u, invalid = 0u;
+    for (auto &f : functions) {
+      if (!f) {
+        ++invalid;
+      } else if (!index.insert(*f)) {
+        ++duplicates;
+      } else {
+        opts.extend();
+        opts.current() = optimum_network(std::move(*f));
+        ++added;
+      }
+    }
+
+    std::cout << fmt::format(
+        "[i] loaded = {}   duplicates = {}   invalid = {}   threads = {}\n",
+        added, duplicates, invalid, pool.size());
+
+    const double totalTime = (double)(clock() - begin) / CLOCKS_PER_SEC;
+    const std::chrono::duration<double> wall =
+        std::chrono::steady_clock::now() - wall_begin;
+    std::cout.setf(std::ios::fixed);
+    std::cout << "[CPU time]   " << std::setprecision(2) << totalTime << " s"
+              << std::endl;
+    std::cout << "[Wall time]  " << std::setprecision(2) << wall.count()
+              << " s" << std::endl;
+  }
+
  private:
   std::string truth_table;
   unsigned odd_inputs;
+  std::string filename;
+  uint32_t num_threads = 0u;
 };
 
 ALICE_ADD_COMMAND(load, "I/O");
@@ -0,0 +1,146 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file lut_map.hpp
+ *
+ * @brief  k-LUT mapping of the current network into the LUT store
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/19
+ */
+
+#ifndef LUT_MAP_HPP
+#define LUT_MAP_HPP
+
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <utility>
+
+#include <mockturtle/algorithms/collapse_mapped.hpp>
+#include <mockturtle/algorithms/lut_mapping.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/views/depth_view.hpp>
+#include <mockturtle/views/mapping_view.hpp>
+
+#include "../core/recovery_variants.hpp"
+
+namespace alice
+{
+    class lut_map_command : public command
+    {
+    public:
+        explicit lut_map_command(const environment::ptr &env)
+            : command(env, "depth-oriented k-LUT mapping with area recovery of the current AIG into the LUT store")
+        {
+            add_flag("--xag, -x", "map the current XAG");
+            add_flag("--mig, -m", "map the current MIG");
+            add_option("--lut_size, -K", lut_size, "number of LUT inputs [default = 6]");
+            add_option("--cut_limit, -C", cut_limit, "number of cuts kept per node [default = 8]");
+            add_option("--area_flow, -F", rounds, "rounds of area flow recovery [default = 2]");
+            add_option("--ela, -E", rounds_ela, "rounds of exact area recovery [default = 1]");
+            add_option("--threads, -j", num_threads, "try this many recovery settings in parallel and keep the fewest LUTs, cut enumeration stays single-threaded [default = 1]");
+            add_flag("--verbose, -v", "toggle verbose printout [default = no]");
+        }
+
+    protected:
+        void execute()
+        {
+            clock_t begin = clock();
+
+            if (lut_size < 2u || lut_size > 16u)
+            {
+                std::cerr << "Error: the LUT size must be between 2 and 16\n";
+                return;
+            }
+
+            std::optional<mockturtle::klut_network> klut;
+            if (is_set("xag"))
+            {
+                if (store<mockturtle::xag_network>().size() == 0u)
+                {
+                    std::cerr << "Error: Empty XAG network\n";
+                    return;
+                }
+                klut = run(store<mockturtle::xag_network>().current());
+            }
+            else if (is_set("mig"))
+            {
+                if (store<mockturtle::mig_network>().size() == 0u)
+                {
+                    std::cerr << "Error: Empty MIG network\n";
+                    return;
+                }
+                klut = run(store<mockturtle::mig_network>().current());
+            }
+            else
+            {
+                if (store<mockturtle::aig_network>().size() == 0u)
+                {
+                    std::cerr << "Error: Empty AIG network\n";
+                    return;
+                }
+                klut = run(store<mockturtle::aig_network>().current());
+            }
+
+            mockturtle::depth_view depth{*klut};
+            std::cout << fmt::format("[i] LUT-{} i/o = {}/{}   LUTs = {}   level = {}\n", lut_size,
+                                     klut->num_pis(), klut->num_pos(), klut->num_gates(), depth.depth());
+            store<mockturtle::klut_network>().extend();
+            store<mockturtle::klut_network>().current() = *klut;
+
+            const double totalTime = (double)(clock() - begin) / CLOCKS_PER_SEC;
+            std::cout.setf(std::ios::fixed);
+            std::cout << "[CPU time]   " << std::setprecision(2) << totalTime << " s" << std::endl;
+        }
+
+    private:
+        /* mockturtle's LUT mapper always selects depth-optimal cuts first
+         * and recovers area under that depth, so there is no separate area
+         * or delay mode, and it enumerates the cuts of one mapping on a
+         * single thread.  `-j` only tries several recovery settings at once
+         * and keeps the fewest LUTs, then the lowest depth. */
+        template <class Ntk>
+        mockturtle::klut_network run(Ntk const &ntk)
+        {
+            using result_t = std::pair<uint32_t, mockturtle::klut_network>;
+            auto map_one = [&](MagicLS::recovery_rounds const &recovery, bool alone) {
+                Ntk copy = ntk.clone();
+                mockturtle::mapping_view<Ntk, true> mapped{copy};
+
+                mockturtle::lut_mapping_params ps;
+                ps.cut_enumeration_ps.cut_size = lut_size;
+                ps.cut_enumeration_ps.cut_limit = cut_limit;
+                ps.rounds = recovery.area_flow;
+                ps.rounds_ela = recovery.exact_area;
+                ps.verbose = is_set("verbose") && alone;
+                mockturtle::lut_mapping<mockturtle::mapping_view<Ntk, true>, true>(mapped, ps);
+
+                auto klut = *mockturtle::collapse_mapped_network<mockturtle::klut_network>(mapped);
+                mockturtle::depth_view depth{klut};
+                return result_t(depth.depth(), klut);
+            };
+            auto better = [](result_t const &a, result_t const &b) {
+                return std::make_pair(a.second.num_gates(), a.first) < std::make_pair(b.second.num_gates(), b.first);
+            };
+            return MagicLS::map_best_recovery({rounds, rounds_ela}, num_threads, map_one, better).second;
+        }
+
+    private:
+        uint32_t lut_size = 6u;
+        uint32_t cut_limit = 8u;
+        uint32_t rounds = 2u;
+        uint32_t rounds_ela = 1u;
+        uint32_t num_threads = 1u;
+    };
+
+    ALICE_ADD_COMMAND(lut_map, "Mapping")
+
+} // namespace alice
+
+#endif
@@ -0,0 +1,149 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file map.hpp
+ *
+ * @brief  technology mapping with mockturtle and the genlib store
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/18
+ */
+
+#ifndef MAP_COMMAND_HPP
+#define MAP_COMMAND_HPP
+
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <mockturtle/algorithms/mapper.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+
+#include "../core/library_manager.hpp"
+#include "../core/recovery_variants.hpp"
+#include "../store.hpp"
+
+namespace alice
+{
+    class map_command : public command
+    {
+    public:
+        explicit map_command(const environment::ptr &env)
+            : command(env, "standard cell mapping of the current AIG with the current genlib")
+        {
+            add_flag("--xag, -x", "map the current XAG");
+            add_flag("--mig, -m", "map the current MIG");
+            add_flag("--area, -a", "area-oriented mapping, skip the delay round [default = no]");
+            add_option("--required, -D", required_time, "required time [default = best delay]");
+            add_option("--area_flow, -F", area_flow_rounds, "rounds of area flow recovery [default = 1]");
+            add_option("--ela, -E", ela_rounds, "rounds of exact area recovery [default = 2]");
+            add_option("--threads, -j", num_threads, "try this many recovery settings in parallel and keep the best, cut enumeration stays single-threaded [default = 1]");
+            add_flag("--verbose, -v", "toggle verbose printout [default = no]");
+        }
+
+    protected:
+        void execute()
+        {
+            clock_t begin = clock();
+
+            if (store<std::vector<mockturtle::gate>>().size() == 0u)
+            {
+                std::cerr << "Error: Empty genlib library, use read_genlib first\n";
+                return;
+            }
+            auto const &gates = store<std::vector<mockturtle::gate>>().current();
+            auto library = MagicLS::library_manager::instance().tech_library(gates);
+
+            if (is_set("xag"))
+            {
+                if (store<mockturtle::xag_network>().size() == 0u)
+                {
+                    std::cerr << "Error: Empty XAG network\n";
+                    return;
+                }
+                run(store<mockturtle::xag_network>().current(), library);
+            }
+            else if (is_set("mig"))
+            {
+                if (store<mockturtle::mig_network>().size() == 0u)
+                {
+                    std::cerr << "Error: Empty MIG network\n";
+                    return;
+                }
+                run(store<mockturtle::mig_network>().current(), library);
+            }
+            else
+            {
+                if (store<mockturtle::aig_network>().size() == 0u)
+                {
+                    std::cerr << "Error: Empty AIG network\n";
+                    return;
+                }
+                run(store<mockturtle::aig_network>().current(), library);
+            }
+
+            const double totalTime = (double)(clock() - begin) / CLOCKS_PER_SEC;
+            std::cout.setf(std::ios::fixed);
+            std::cout << "[CPU time]   " << std::setprecision(2) << totalTime << " s" << std::endl;
+        }
+
+    private:
+        /* Mapping is single threaded inside mockturtle, so `-j` only maps
+         * the network with several recovery settings at once; every run
+         * works on its own copy because mapping updates the traversal
+         * state. */
+        template <class Ntk>
+        void run(Ntk const &ntk, std::shared_ptr<MagicLS::cell_library> const &library)
+        {
+            mockturtle::map_params base;
+            base.skip_delay_round = is_set("area");
+            base.verbose = is_set("verbose");
+            if (is_set("required"))
+                base.required_time = required_time;
+
+            using result_t = std::pair<mapped_network::network_t, mockturtle::map_stats>;
+            auto map_one = [&](MagicLS::recovery_rounds const &recovery, bool alone) {
+                auto ps = base;
+                ps.area_flow_rounds = recovery.area_flow;
+                ps.ela_rounds = recovery.exact_area;
+                ps.verbose = base.verbose && alone;
+                mockturtle::map_stats st;
+                Ntk copy = alone ? ntk : ntk.clone();
+                auto res = mockturtle::map<Ntk, 6u>(copy, *library, ps, &st);
+                return result_t(std::move(res), st);
+            };
+            /* area first in area mode, delay first otherwise */
+            auto better = [&](result_t const &x, result_t const &y) {
+                auto const &a = x.second;
+                auto const &b = y.second;
+                if (is_set("area"))
+                    return std::tie(a.area, a.delay) < std::tie(b.area, b.delay);
+                return std::tie(a.delay, a.area) < std::tie(b.delay, b.area);
+            };
+
+            auto [res, st] = MagicLS::map_best_recovery({area_flow_rounds, ela_rounds}, num_threads, map_one, better);
+            std::cout << fmt::format("[i] cells = {}   area = {:.2f}   delay = {:.2f}\n", res.num_gates(), st.area, st.delay);
+
+            store<mapped_network>().extend();
+            store<mapped_network>().current() = mapped_network(res, library, st.area, st.delay);
+        }
+
+    private:
+        double required_time = 0.0;
+        uint32_t area_flow_rounds = 1u;
+        uint32_t ela_rounds = 2u;
+        uint32_t num_threads = 1u;
+    };
+
+    ALICE_ADD_COMMAND(map, "Mapping")
+
+} // namespace alice
+
+#endif
@@ -0,0 +1,76 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file memo.hpp
+ *
+ * @brief  control the memoization of ABC and GIA optimization commands
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/24
+ */
+
+#ifndef MEMO_COMMAND_HPP
+#define MEMO_COMMAND_HPP
+
+#include <iostream>
+#include <string>
+
+#include "../core/memo_cache.hpp"
+
+namespace alice
+{
+    class memo_command : public command
+    {
+    public:
+        explicit memo_command(const environment::ptr &env)
+            : command(env, "reuse results of ABC and GIA optimization commands on identical inputs")
+        {
+            add_flag("--enable, -e", "enable memoization");
+            add_flag("--disable, -d", "disable memoization");
+            add_option("--capacity, -n", capacity, "maximum number of results kept in memory per store [default = 256]");
+            add_option("--path, -p", directory, "also keep results in this directory, \"\" for memory only");
+            add_flag("--clear, -c", "remove all results kept in memory");
+        }
+
+    protected:
+        void execute()
+        {
+            auto &settings = MagicLS::memo_settings::instance();
+            auto &abc = MagicLS::memo_cache<pabc::Abc_Ntk_t *>::instance();
+            auto &gia = MagicLS::memo_cache<pabc::Gia_Man_t *>::instance();
+
+            if (is_set("enable"))
+                settings.enabled = true;
+            if (is_set("disable"))
+                settings.enabled = false;
+            if (is_set("path"))
+                settings.directory = directory;
+            if (is_set("capacity"))
+            {
+                settings.capacity = capacity;
+                abc.shrink();
+                gia.shrink();
+            }
+            if (is_set("clear"))
+            {
+                abc.clear();
+                gia.clear();
+            }
+
+            std::cout << fmt::format("[i] memo: {}   capacity = {}   path = {}\n", settings.enabled ? "on" : "off",
+                                     settings.capacity, settings.directory.empty() ? "-" : settings.directory);
+            std::cout << "[i] ABC: " << abc.report() << "\n";
+            std::cout << "[i] GIA: " << gia.report() << "\n";
+        }
+
+    private:
+        uint32_t capacity = 256u;
+        std::string directory;
+    };
+
+    ALICE_ADD_COMMAND(memo, "General")
+
+} // namespace alice
+
+#endif
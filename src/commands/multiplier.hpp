@@ -43,6 +43,9 @@ namespace alice
             add_flag("--carry_ripple_multiplier, -m", "create carry ripple multiplier based on full adder");
             add_flag("--new_multiplier, -n", "create new multiplier based on kogge-stone based full adder");
             add_option("-a, --advance", func, "set the advanced adder to the partial product adder function, set{brent-kung; kogge-stone; han-carlson;}");
+            add_flag("--fma, -c", "create fused multiply-add a*b+c, the addend c has BIT+BIT_1 bits");
+            add_flag("--tree_multiplier, -t", "create compressor tree multiplier with a single final adder");
+            add_flag("--wallace, -w", "use only 3:2 compressors in the partial product tree [default = 4:2 and 3:2]");
             add_flag("--print_tt, -p", "print the network's output truth table (BIT <= 8).");
         }
 
@@ -121,6 +124,57 @@ namespace alice
 
                     MagicLS::print_stats(aig);
                 }
+                else if (is_set("fma") || is_set("tree_multiplier"))
+                {
+                    // the final adder is selected by "-a", default han-carlson
+                    const std::string final_adder = func.empty() ? "han-carlson" : func;
+                    auto adder = prefix_adder_by_name<aig_network>(final_adder);
+                    if (adder == nullptr)
+                    {
+                        std::cout << "error: no " << final_adder << "function!" << std::endl;
+                        return;
+                    }
+                    aig_network aig;
+                    std::vector<aig_network::signal> a(BIT), b(is_set("bit1") ? BIT_1 : BIT), c{};
+                    std::cout << "multiplicand bit: " << a.size() << " multiplier bit: " << b.size() << std::endl;
+                    std::generate(a.begin(), a.end(), [&aig]()
+                                  { return aig.create_pi(); });
+                    std::generate(b.begin(), b.end(), [&aig]()
+                                  { return aig.create_pi(); });
+                    if (is_set("fma"))
+                    {
+                        std::cout << "fused multiply-add with final adder: " << final_adder << "\n";
+                        c.resize(a.size() + b.size());
+                        std::generate(c.begin(), c.end(), [&aig]()
+                                      { return aig.create_pi(); });
+                    }
+                    else
+                    {
+                        std::cout << "compressor tree multiplier with final adder: " << final_adder << "\n";
+                    }
+
+                    const auto results = fused_multiply_add(aig, a, b, c, adder, !is_set("wallace"));
+                    for (const auto &result : results)
+                    {
+                        aig.create_po(result);
+                    }
+
+                    if (is_set("print_tt") && aig.num_pis() <= 16u)
+                    {
+                        default_simulator<kitty::dynamic_truth_table> sim(aig.num_pis());
+                        const auto tts = simulate<kitty::dynamic_truth_table>(aig, sim);
+
+                        aig.foreach_po([&](auto const &, auto i)
+                                       { std::cout << fmt::format("truth table of output {} is {}\n", i, kitty::to_hex(tts[i])); });
+                    }
+
+                    aig = cleanup_dangling(aig);
+
+                    store<aig_network>().extend();
+                    store<aig_network>().current() = aig;
+
+                    MagicLS::print_stats(aig);
+                }
                 else if (is_set("advance"))
                 {
                     aig_network aig;
@@ -0,0 +1,100 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file network_opt.hpp
+ *
+ * @brief  common driver of the native optimization commands
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/22
+ */
+
+#ifndef NETWORK_OPT_COMMAND_HPP
+#define NETWORK_OPT_COMMAND_HPP
+
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+
+#include "../core/network_opt.hpp"
+#include "../core/store_stats.hpp"
+#include "../core/struct_hash.hpp"
+#include "../store.hpp"
+
+namespace alice
+{
+    /* Selects the store from the flags, runs `Derived::optimize` on its
+     * current network without leaving the representation and reports the
+     * size and depth before and after.  `Derived::supports<Ntk>` lists the
+     * network types a pass accepts. */
+    template <class Derived>
+    class network_opt_command : public command
+    {
+    public:
+        network_opt_command(const environment::ptr &env, const std::string &caption)
+            : command(env, caption)
+        {
+            add_flag("--mig, -m", "optimize the current MIG");
+            add_flag("--xag, -x", "optimize the current XAG");
+            add_flag("--xmg, -g", "optimize the current XMG");
+            add_flag("--verbose, -v", "toggle verbose printout [default = no]");
+        }
+
+    protected:
+        void execute()
+        {
+            clock_t begin = clock();
+
+            if (is_set("mig"))
+                run<mockturtle::mig_network>("MIG");
+            else if (is_set("xag"))
+                run<mockturtle::xag_network>("XAG");
+            else if (is_set("xmg"))
+                run<mockturtle::xmg_network>("XMG");
+            else
+                run<mockturtle::aig_network>("AIG");
+
+            const double totalTime = (double)(clock() - begin) / CLOCKS_PER_SEC;
+            std::cout.setf(std::ios::fixed);
+            std::cout << "[CPU time]   " << std::setprecision(2) << totalTime << " s" << std::endl;
+        }
+
+    private:
+        template <class Ntk>
+        void run(const char *name)
+        {
+            if constexpr (!Derived::template supports<Ntk>)
+            {
+                std::cerr << "Error: this command does not optimize " << name << " networks\n";
+            }
+            else
+            {
+                if (store<Ntk>().size() == 0u)
+                {
+                    std::cerr << "Error: Empty " << name << " network\n";
+                    return;
+                }
+                Ntk const &ntk = store<Ntk>().current();
+                const auto before = MagicLS::cached_stats(ntk);
+                const auto before_hash = MagicLS::structural_hash(ntk);
+
+                Ntk opt = static_cast<Derived *>(this)->optimize(ntk);
+
+                const auto &after = MagicLS::cached_stats(opt);
+                std::cout << fmt::format("[i] {}   gates = {} -> {}   level = {} -> {}\n", name, before.gates,
+                                         after.gates, before.levels, after.levels);
+                extend_unique(store<Ntk>(), opt, before_hash);
+            }
+        }
+    };
+
+} // namespace alice
+
+#endif
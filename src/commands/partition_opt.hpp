@@ -0,0 +1,168 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file partition_opt.hpp
+ *
+ * @brief  optimize large networks window by window in parallel
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/23
+ */
+
+#ifndef PARTITION_OPT_COMMAND_HPP
+#define PARTITION_OPT_COMMAND_HPP
+
+#include <chrono>
+#include <ctime>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/views/depth_view.hpp>
+
+#include "../core/abc.hpp"
+#include "../core/network_opt.hpp"
+#include "../core/partition_opt.hpp"
+#include "../core/thread_pool.hpp"
+
+namespace alice
+{
+    class partition_opt_command : public command
+    {
+    public:
+        explicit partition_opt_command(const environment::ptr &env)
+            : command(env, "optimize windows of the current AIG or GIA in parallel and stitch them back")
+        {
+            add_flag("--gia, -g", "optimize the current GIA instead of the current AIG");
+            add_option("--window, -S", window_size, "maximum number of gates of a window [default = 20000]");
+            add_option("--pass, -p", pass, "mockturtle pass per window: rewrite, resub, balance or refactor [default = resub]");
+            add_option("--script, -s", script, "run this ABC9 script on every window instead, e.g. \"&st; &dc2\"");
+            add_option("--threads, -j", num_threads, "number of worker threads [default = all cores]");
+        }
+
+    protected:
+        void execute()
+        {
+            clock_t begin = clock();
+            const auto wall_begin = std::chrono::steady_clock::now();
+
+            auto optimize = window_function();
+            if (!optimize)
+            {
+                std::cerr << "Error: unknown pass " << pass << "\n";
+                return;
+            }
+
+            mockturtle::aig_network aig;
+            if (is_set("gia"))
+            {
+                if (store<pabc::Gia_Man_t *>().size() == 0u)
+                {
+                    std::cerr << "Error: Empty GIA\n";
+                    return;
+                }
+                mockturtle::gia_network gia(store<pabc::Gia_Man_t *>().current());
+                mockturtle::gia_to_aig(aig, gia);
+            }
+            else
+            {
+                if (store<mockturtle::aig_network>().size() == 0u)
+                {
+                    std::cerr << "Error: Empty AIG network\n";
+                    return;
+                }
+                aig = store<mockturtle::aig_network>().current();
+            }
+
+            MagicLS::thread_pool pool(num_threads);
+            MagicLS::partition_opt_stats st;
+            auto res = MagicLS::partition_optimize(aig, window_size, pool, optimize, &st);
+
+            std::cout << fmt::format("[i] windows = {}   improved = {}   failed = {}   threads = {}\n", st.windows,
+                                     st.improved, st.failed, pool.size());
+            std::cout << fmt::format("[i] gates = {} -> {}   level = {} -> {}\n", aig.num_gates(), res.num_gates(),
+                                     mockturtle::depth_view(aig).depth(), mockturtle::depth_view(res).depth());
+
+            if (is_set("gia"))
+            {
+                mockturtle::gia_network gia(res.size() << 1);
+                mockturtle::aig_to_gia(gia, res);
+                extend_unique(store<pabc::Gia_Man_t *>(), const_cast<pabc::Gia_Man_t *>(gia.get_gia()));
+            }
+            else
+            {
+                extend_unique(store<mockturtle::aig_network>(), res);
+            }
+
+            /* the windows run concurrently, so CPU time overstates the run time */
+            const double totalTime = (double)(clock() - begin) / CLOCKS_PER_SEC;
+            const std::chrono::duration<double> wall = std::chrono::steady_clock::now() - wall_begin;
+            std::cout.setf(std::ios::fixed);
+            std::cout << "[CPU time]   " << std::setprecision(2) << totalTime << " s" << std::endl;
+            std::cout << "[Wall time]  " << std::setprecision(2) << wall.count() << " s" << std::endl;
+        }
+
+    private:
+        using window_fn = std::function<mockturtle::aig_network(mockturtle::aig_network const &)>;
+
+        /* ABC scripts share the global frame and run one window at a time,
+         * the mockturtle passes run on all workers */
+        window_fn window_function() const
+        {
+            if (is_set("script"))
+            {
+                const auto s = script;
+                return [s](mockturtle::aig_network const &win) {
+                    std::lock_guard<std::mutex> lock(MagicLS::abc_mutex());
+                    return mockturtle::call_abc_script(win, s);
+                };
+            }
+            if (pass == "rewrite")
+            {
+                return [](mockturtle::aig_network const &win) {
+                    mockturtle::cut_rewriting_params ps;
+                    ps.cut_enumeration_ps.cut_size = 4u;
+                    return MagicLS::cut_rewrite(win, ps);
+                };
+            }
+            if (pass == "resub")
+            {
+                return [](mockturtle::aig_network const &win) {
+                    mockturtle::resubstitution_params ps;
+                    return MagicLS::resubstitute(win, ps);
+                };
+            }
+            if (pass == "balance")
+            {
+                return [](mockturtle::aig_network const &win) {
+                    mockturtle::balancing_params ps;
+                    ps.cut_enumeration_ps.cut_size = 4u;
+                    return MagicLS::sop_balance(win, ps);
+                };
+            }
+            if (pass == "refactor")
+            {
+                return [](mockturtle::aig_network const &win) {
+                    mockturtle::refactoring_params ps;
+                    return MagicLS::refactor(win, ps);
+                };
+            }
+            return {};
+        }
+
+    private:
+        uint32_t window_size = 20000u;
+        std::string pass = "resub";
+        std::string script;
+        uint32_t num_threads = 0u;
+    };
+
+    ALICE_ADD_COMMAND(partition_opt, "Synthesis")
+
+} // namespace alice
+
+#endif
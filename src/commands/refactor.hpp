@@ -0,0 +1,58 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file refactor.hpp
+ *
+ * @brief  refactoring with SOP factoring
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/22
+ */
+
+#ifndef REFACTOR_COMMAND_HPP
+#define REFACTOR_COMMAND_HPP
+
+#include "./network_opt.hpp"
+
+namespace alice
+{
+    class refactor_command : public network_opt_command<refactor_command>
+    {
+    public:
+        explicit refactor_command(const environment::ptr &env)
+            : network_opt_command(env, "refactoring of the current AIG, MIG, XAG or XMG")
+        {
+            add_option("--max_pis, -K", max_pis, "maximum number of leaves of a collapsed cone [default = 6]");
+            add_flag("--zero_gain, -z", "toggle using zero-cost replacements [default = no]");
+            add_flag("--dont_cares, -c", "toggle using satisfiability don't cares [default = no]");
+        }
+
+        template <class Ntk>
+        static constexpr bool supports = true;
+
+        template <class Ntk>
+        Ntk optimize(Ntk const &ntk)
+        {
+            mockturtle::refactoring_params ps;
+            ps.max_pis = max_pis;
+            ps.allow_zero_gain = is_set("zero_gain");
+            ps.use_dont_cares = is_set("dont_cares");
+            ps.verbose = is_set("verbose");
+
+            mockturtle::refactoring_stats st;
+            Ntk res = MagicLS::refactor(ntk, ps, &st);
+            if (is_set("verbose"))
+                st.report();
+            return res;
+        }
+
+    private:
+        uint32_t max_pis = 6u;
+    };
+
+    ALICE_ADD_COMMAND(refactor, "Synthesis")
+
+} // namespace alice
+
+#endif
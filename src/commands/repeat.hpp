@@ -0,0 +1,209 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file repeat.hpp
+ *
+ * @brief  repeat a script until the current network stops improving
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/26
+ */
+
+#ifndef REPEAT_COMMAND_HPP
+#define REPEAT_COMMAND_HPP
+
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../core/store_stats.hpp"
+#include "../core/struct_hash.hpp"
+
+namespace alice
+{
+    class repeat_command : public command
+    {
+        /* gates and levels of the current network */
+        using counters = std::pair<uint64_t, uint64_t>;
+
+    public:
+        explicit repeat_command(const environment::ptr &env)
+            : command(env, "repeat a script until the current network stops improving")
+        {
+            add_option("script, --script, -s", script, "commands separated by ';', e.g. \"rewrite; refactor; resub; balance\"")->required();
+            add_option("--iterations, -N", max_iterations, "maximum number of iterations [default = 10]");
+            add_option("--time, -T", time_budget, "time budget in seconds, 0 for none [default = 0]");
+            add_flag("--mig, -m", "measure the current MIG");
+            add_flag("--xag, -x", "measure the current XAG");
+            add_flag("--xmg, -g", "measure the current XMG");
+            add_flag("--abc, -b", "measure the current ABC network");
+            add_flag("--gia, -i", "measure the current GIA");
+        }
+
+    protected:
+        void execute()
+        {
+            clock_t begin = clock();
+            const auto wall_begin = std::chrono::steady_clock::now();
+
+            const auto lines = split(script);
+            for (auto const &line : lines)
+            {
+                if (env->commands().count(line.front()) == 0u || line.front() == "repeat")
+                {
+                    std::cerr << "Error: unknown or recursive command " << line.front() << "\n";
+                    return;
+                }
+            }
+
+            auto current = measure();
+            if (!current)
+            {
+                std::cerr << "Error: the measured store is empty\n";
+                return;
+            }
+            /* structures seen at the current counters, to detect cycles */
+            std::unordered_set<uint64_t> seen{fingerprint()};
+            const auto initial = *current;
+
+            for (auto i = 1u; i <= max_iterations; ++i)
+            {
+                for (auto const &line : lines)
+                {
+                    if (!env->commands().at(line.front())->run(line))
+                    {
+                        std::cerr << "Error: " << line.front() << " has failed, stopping\n";
+                        return;
+                    }
+                }
+
+                const auto next = *measure();
+                std::cout << fmt::format("[i] iteration {}: gates {} -> {} ({:+})   level {} -> {} ({:+})\n", i, current->first,
+                                         next.first, (int64_t)next.first - (int64_t)current->first, current->second,
+                                         next.second, (int64_t)next.second - (int64_t)current->second);
+
+                /* with equal counters the script may still have moved to a
+                 * new structure, from which a later iteration can improve;
+                 * it stops once a structure repeats */
+                const auto improved = next.first < current->first || next.second < current->second;
+                const auto same_cost = next == *current;
+                current = next;
+
+                if (improved)
+                {
+                    seen = {fingerprint()};
+                }
+                else if (!same_cost)
+                {
+                    std::cout << "[i] no further gain\n";
+                    break;
+                }
+                else if (!seen.insert(fingerprint()).second)
+                {
+                    std::cout << "[i] fixed point reached\n";
+                    break;
+                }
+                const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - wall_begin;
+                if (time_budget > 0.0 && elapsed.count() > time_budget)
+                {
+                    std::cout << "[i] time budget exhausted\n";
+                    break;
+                }
+            }
+
+            std::cout << fmt::format("[i] total: gates {} -> {}   level {} -> {}\n", initial.first, current->first,
+                                     initial.second, current->second);
+
+            const double totalTime = (double)(clock() - begin) / CLOCKS_PER_SEC;
+            std::cout.setf(std::ios::fixed);
+            std::cout << "[CPU time]   " << std::setprecision(2) << totalTime << " s" << std::endl;
+        }
+
+    private:
+        /* one argument vector per command, the command name first */
+        static std::vector<std::vector<std::string>> split(std::string const &s)
+        {
+            std::vector<std::vector<std::string>> lines;
+            std::istringstream commands(s);
+            std::string command;
+            while (std::getline(commands, command, ';'))
+            {
+                std::istringstream words(command);
+                std::vector<std::string> line;
+                std::string word;
+                while (words >> std::quoted(word))
+                    line.push_back(word);
+                if (!line.empty())
+                    lines.push_back(line);
+            }
+            return lines;
+        }
+
+        std::optional<counters> measure()
+        {
+            if (is_set("abc"))
+            {
+                if (store<pabc::Abc_Ntk_t *>().size() == 0u)
+                    return std::nullopt;
+                auto *pNtk = store<pabc::Abc_Ntk_t *>().current();
+                return counters(pabc::Abc_NtkNodeNum(pNtk), pabc::Abc_NtkLevel(pNtk));
+            }
+            if (is_set("gia"))
+            {
+                if (store<pabc::Gia_Man_t *>().size() == 0u)
+                    return std::nullopt;
+                auto *gia = store<pabc::Gia_Man_t *>().current();
+                return counters(pabc::Gia_ManAndNum(gia), MagicLS::cached_gia_levels(gia));
+            }
+            if (is_set("mig"))
+                return measure<mockturtle::mig_network>();
+            if (is_set("xag"))
+                return measure<mockturtle::xag_network>();
+            if (is_set("xmg"))
+                return measure<mockturtle::xmg_network>();
+            return measure<mockturtle::aig_network>();
+        }
+
+        template <class Ntk>
+        std::optional<counters> measure()
+        {
+            if (store<Ntk>().size() == 0u)
+                return std::nullopt;
+            auto const &st = MagicLS::cached_stats(store<Ntk>().current());
+            return counters(st.gates, st.levels);
+        }
+
+        uint64_t fingerprint()
+        {
+            if (is_set("abc"))
+                return MagicLS::structural_hash(store<pabc::Abc_Ntk_t *>().current());
+            if (is_set("gia"))
+                return MagicLS::structural_hash(store<pabc::Gia_Man_t *>().current());
+            if (is_set("mig"))
+                return MagicLS::structural_hash(store<mockturtle::mig_network>().current());
+            if (is_set("xag"))
+                return MagicLS::structural_hash(store<mockturtle::xag_network>().current());
+            if (is_set("xmg"))
+                return MagicLS::structural_hash(store<mockturtle::xmg_network>().current());
+            return MagicLS::structural_hash(store<mockturtle::aig_network>().current());
+        }
+
+    private:
+        std::string script;
+        uint32_t max_iterations = 10u;
+        double time_budget = 0.0;
+    };
+
+    ALICE_ADD_COMMAND(repeat, "General")
+
+} // namespace alice
+
+#endif
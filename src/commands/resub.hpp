@@ -0,0 +1,64 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file resub.hpp
+ *
+ * @brief  windowed resubstitution
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/22
+ */
+
+#ifndef RESUB_COMMAND_HPP
+#define RESUB_COMMAND_HPP
+
+#include "./network_opt.hpp"
+
+namespace alice
+{
+    class resub_command : public network_opt_command<resub_command>
+    {
+    public:
+        explicit resub_command(const environment::ptr &env)
+            : network_opt_command(env, "resubstitution of the current AIG, MIG, XAG or XMG")
+        {
+            add_option("--max_pis, -K", max_pis, "maximum number of leaves of a window [default = 8]");
+            add_option("--inserts, -N", max_inserts, "maximum number of nodes added per replacement [default = 2]");
+            add_option("--divisors, -D", max_divisors, "maximum number of divisors [default = 150]");
+            add_flag("--depth, -d", "toggle preserving the depth [default = no]");
+            add_flag("--dont_cares, -c", "toggle using satisfiability don't cares [default = no]");
+        }
+
+        template <class Ntk>
+        static constexpr bool supports = true;
+
+        template <class Ntk>
+        Ntk optimize(Ntk const &ntk)
+        {
+            mockturtle::resubstitution_params ps;
+            ps.max_pis = max_pis;
+            ps.max_inserts = max_inserts;
+            ps.max_divisors = max_divisors;
+            ps.preserve_depth = is_set("depth");
+            ps.use_dont_cares = is_set("dont_cares");
+            ps.verbose = is_set("verbose");
+
+            mockturtle::resubstitution_stats st;
+            Ntk res = MagicLS::resubstitute(ntk, ps, &st);
+            if (is_set("verbose"))
+                st.report();
+            return res;
+        }
+
+    private:
+        uint32_t max_pis = 8u;
+        uint32_t max_inserts = 2u;
+        uint32_t max_divisors = 150u;
+    };
+
+    ALICE_ADD_COMMAND(resub, "Synthesis")
+
+} // namespace alice
+
+#endif
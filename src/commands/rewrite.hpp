@@ -0,0 +1,59 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file rewrite.hpp
+ *
+ * @brief  cut rewriting with exact 4-input NPN databases
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/22
+ */
+
+#ifndef REWRITE_COMMAND_HPP
+#define REWRITE_COMMAND_HPP
+
+#include "./network_opt.hpp"
+
+namespace alice
+{
+    class rewrite_command : public network_opt_command<rewrite_command>
+    {
+    public:
+        explicit rewrite_command(const environment::ptr &env)
+            : network_opt_command(env, "cut rewriting of the current AIG, MIG, XAG or XMG")
+        {
+            add_option("--cut_limit, -C", cut_limit, "number of cuts kept per node [default = 12]");
+            add_flag("--zero_gain, -z", "toggle using zero-cost replacements [default = no]");
+            add_flag("--depth, -d", "toggle preserving the depth [default = no]");
+        }
+
+        template <class Ntk>
+        static constexpr bool supports = true;
+
+        template <class Ntk>
+        Ntk optimize(Ntk const &ntk)
+        {
+            mockturtle::cut_rewriting_params ps;
+            ps.cut_enumeration_ps.cut_size = 4u;
+            ps.cut_enumeration_ps.cut_limit = cut_limit;
+            ps.allow_zero_gain = is_set("zero_gain");
+            ps.preserve_depth = is_set("depth");
+            ps.verbose = is_set("verbose");
+
+            mockturtle::cut_rewriting_stats st;
+            Ntk res = MagicLS::cut_rewrite(ntk, ps, &st);
+            if (is_set("verbose"))
+                st.report();
+            return res;
+        }
+
+    private:
+        uint32_t cut_limit = 12u;
+    };
+
+    ALICE_ADD_COMMAND(rewrite, "Synthesis")
+
+} // namespace alice
+
+#endif
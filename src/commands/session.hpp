@@ -0,0 +1,234 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file session.hpp
+ *
+ * @brief  save and restore all stores as one binary session file
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/10
+ */
+
+#ifndef SESSION_COMMAND_HPP
+#define SESSION_COMMAND_HPP
+
+#include <ctime>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../core/session.hpp"
+#include "../store.hpp"
+
+namespace alice
+{
+    namespace detail
+    {
+        template <typename T, typename SaveFn>
+        void save_section(store_container<T> &st, MagicLS::session_writer &w, MagicLS::session_tag tag, SaveFn &&save)
+        {
+            if (st.size() == 0u)
+                return;
+            w.begin_section(tag, static_cast<uint32_t>(st.size()));
+            for (auto i = 0u; i < st.size(); ++i)
+            {
+                w.entry(save(st[i]));
+            }
+        }
+    } // namespace detail
+
+    class save_session_command : public command
+    {
+    public:
+        explicit save_session_command(const environment::ptr &env)
+            : command(env, "save all store entries into a binary session file")
+        {
+            add_option("filename,-f,--filename", filename, "session file");
+        }
+
+    protected:
+        void execute()
+        {
+            clock_t begin = clock();
+            try
+            {
+                MagicLS::session_writer w(filename);
+                auto network = [](auto const &ntk) { return MagicLS::save_network(ntk); };
+
+                detail::save_section(store<mockturtle::aig_network>(), w, MagicLS::session_tag::aig, network);
+                detail::save_section(store<mockturtle::mig_network>(), w, MagicLS::session_tag::mig, network);
+                detail::save_section(store<mockturtle::xag_network>(), w, MagicLS::session_tag::xag, network);
+                detail::save_section(store<mockturtle::xmg_network>(), w, MagicLS::session_tag::xmg, network);
+                detail::save_section(store<mockturtle::klut_network>(), w, MagicLS::session_tag::klut, network);
+                detail::save_section(store<pabc::Abc_Ntk_t *>(), w, MagicLS::session_tag::abc, network);
+                detail::save_section(store<pabc::Gia_Man_t *>(), w, MagicLS::session_tag::gia, network);
+                detail::save_section(store<std::vector<mockturtle::gate>>(), w, MagicLS::session_tag::genlib,
+                                     [](auto const &gates) { return MagicLS::save_library(gates); });
+                detail::save_section(store<optimum_network>(), w, MagicLS::session_tag::opt,
+                                     [](optimum_network const &opt)
+                                     {
+                                         MagicLS::payload_writer pw;
+                                         pw.put(opt.function);
+                                         pw.put(opt.network);
+                                         return pw.str();
+                                     });
+                if (!w.finish())
+                {
+                    std::cerr << "[e] could not write " << filename << "\n";
+                    return;
+                }
+            }
+            catch (std::exception const &e)
+            {
+                std::cerr << "[e] " << e.what() << "\n";
+                return;
+            }
+
+            const double totalTime = (double)(clock() - begin) / CLOCKS_PER_SEC;
+            std::cout.setf(std::ios::fixed);
+            std::cout << "[CPU time]   " << std::setprecision(2) << totalTime << " s" << std::endl;
+        }
+
+    private:
+        std::string filename;
+    };
+
+    class load_session_command : public command
+    {
+    public:
+        explicit load_session_command(const environment::ptr &env)
+            : command(env, "append the entries of a binary session file to the stores")
+        {
+            add_option("filename,-f,--filename", filename, "session file");
+        }
+
+    protected:
+        void execute()
+        {
+            clock_t begin = clock();
+            /* entries are loaded first and pushed only if the whole file is
+             * valid, so a failing load leaves the stores untouched */
+            std::vector<pending_entry> pending;
+            try
+            {
+                MagicLS::mapped_file file(filename);
+                MagicLS::payload_reader header(file.data(), file.size());
+                if (std::string(header.take(4), 4) != "MLSS")
+                {
+                    std::cerr << "[e] " << filename << " is not a session file\n";
+                    return;
+                }
+                if (const auto version = header.get<uint32_t>(); version != MagicLS::session_version)
+                {
+                    std::cerr << "[e] unsupported session version " << version << "\n";
+                    return;
+                }
+                const auto num_sections = header.get<uint32_t>();
+                header.align();
+
+                for (auto s = 0u; s < num_sections; ++s)
+                {
+                    const auto tag = static_cast<MagicLS::session_tag>(header.get<uint32_t>());
+                    const auto num_entries = header.get<uint32_t>();
+                    for (auto e = 0u; e < num_entries; ++e)
+                    {
+                        const auto size = header.get<uint64_t>();
+                        MagicLS::payload_reader r(header.take(size), size);
+                        header.align();
+                        if (auto entry = restore(tag, r))
+                            pending.push_back(std::move(*entry));
+                    }
+                }
+            }
+            catch (std::exception const &e)
+            {
+                for (auto &entry : pending)
+                {
+                    if (entry.discard)
+                        entry.discard();
+                }
+                std::cerr << "[e] " << e.what() << "\n";
+                return;
+            }
+
+            for (auto &entry : pending)
+                entry.commit();
+
+            const double totalTime = (double)(clock() - begin) / CLOCKS_PER_SEC;
+            std::cout.setf(std::ios::fixed);
+            std::cout << "[CPU time]   " << std::setprecision(2) << totalTime << " s" << std::endl;
+        }
+
+    private:
+        struct pending_entry
+        {
+            std::function<void()> commit;
+            /* releases ABC/GIA networks that were never pushed */
+            std::function<void()> discard;
+        };
+
+        template <typename T>
+        static pending_entry stage(T element)
+        {
+            pending_entry entry;
+            entry.commit = [element]()
+            {
+                store<T>().extend();
+                store<T>().current() = element;
+            };
+            if constexpr (std::is_pointer_v<T>)
+                entry.discard = [element]() { detail::release_network(element); };
+            return entry;
+        }
+
+        std::optional<pending_entry> restore(MagicLS::session_tag tag, MagicLS::payload_reader &r)
+        {
+            using MagicLS::session_tag;
+            switch (tag)
+            {
+            case session_tag::aig:
+                return stage(MagicLS::load_network<mockturtle::aig_network>(r));
+            case session_tag::mig:
+                return stage(MagicLS::load_network<mockturtle::mig_network>(r));
+            case session_tag::xag:
+                return stage(MagicLS::load_network<mockturtle::xag_network>(r));
+            case session_tag::xmg:
+                return stage(MagicLS::load_network<mockturtle::xmg_network>(r));
+            case session_tag::klut:
+                return stage(MagicLS::load_network<mockturtle::klut_network>(r));
+            case session_tag::abc:
+                return stage(MagicLS::load_abc(r));
+            case session_tag::gia:
+            {
+                const auto size = r.remaining();
+                return stage(MagicLS::load_gia(std::string(r.take(size), size)));
+            }
+            case session_tag::genlib:
+                return stage(MagicLS::load_library(r));
+            case session_tag::opt:
+            {
+                optimum_network opt(r.get_tt());
+                opt.network = r.get_string();
+                return stage(opt);
+            }
+            default:
+                std::cerr << "[w] skipping unknown session entry\n";
+                return std::nullopt;
+            }
+        }
+
+    private:
+        std::string filename;
+    };
+
+    ALICE_ADD_COMMAND(save_session, "I/O")
+    ALICE_ADD_COMMAND(load_session, "I/O")
+
+} // namespace alice
+
+#endif
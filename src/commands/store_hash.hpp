@@ -0,0 +1,57 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file store_hash.hpp
+ *
+ * @brief  print structural hashes of the current store entries
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/08
+ */
+
+#ifndef STORE_HASH_HPP
+#define STORE_HASH_HPP
+
+#include <iostream>
+
+#include "../core/struct_hash.hpp"
+
+namespace alice
+{
+    class store_hash_command : public command
+    {
+    public:
+        explicit store_hash_command(const environment::ptr &env)
+            : command(env, "print structural hashes and whether the last store update changed the network")
+        {
+            add_flag("--aig, -a", "hash the current AIG");
+            add_flag("--gia, -g", "hash the current GIA");
+            add_flag("--abc, -b", "hash the current ABC network");
+        }
+
+    protected:
+        void execute()
+        {
+            if (is_set("aig") && store<mockturtle::aig_network>().size() != 0u)
+            {
+                std::cout << fmt::format("[i] AIG hash = {:016x}\n", MagicLS::structural_hash(store<mockturtle::aig_network>().current()));
+            }
+            if (is_set("gia") && store<pabc::Gia_Man_t *>().size() != 0u)
+            {
+                std::cout << fmt::format("[i] GIA hash = {:016x}\n", MagicLS::structural_hash(store<pabc::Gia_Man_t *>().current()));
+            }
+            if (is_set("abc") && store<pabc::Abc_Ntk_t *>().size() != 0u)
+            {
+                std::cout << fmt::format("[i] ABC hash = {:016x}\n", MagicLS::structural_hash(store<pabc::Abc_Ntk_t *>().current()));
+            }
+
+            std::cout << "[i] last store update: " << (MagicLS::last_store_changed() ? "changed" : "unchanged") << "\n";
+        }
+    };
+
+    ALICE_ADD_COMMAND(store_hash, "General")
+
+} // namespace alice
+
+#endif
@@ -29,6 +29,9 @@ Aig_Man_t * Gia_ManToAig( Gia_Man_t * p, int fChoices );
 Gia_Man_t * Gia_ManFromAig( Aig_Man_t * p );
 Abc_Ntk_t * Abc_NtkFromAigPhase( Aig_Man_t * pMan );
 Aig_Man_t * Abc_NtkToDar( Abc_Ntk_t * pNtk, int fExors, int fRegisters );
+Aig_Man_t * Abc_NtkToDarChoices( Abc_Ntk_t * pNtk );
+Gia_Man_t * Gia_ManFromAigChoices( Aig_Man_t * p );
+Abc_Ntk_t * Abc_NtkMap( Abc_Ntk_t * pNtk, double DelayTarget, double AreaMulti, double DelayMulti, float LogFan, float Slew, float Gain, int nGatesMin, int fRecovery, int fSwitching, int fSkipFanout, int fUseProfile, int fUseBuffs, int fVerbose );
 }
 
 #endif
@@ -19,6 +19,8 @@
 #include <mockturtle/networks/detail/foreach.hpp>
 #include <kitty/dynamic_truth_table.hpp>
 
+#include "./store_stats.hpp"
+
 namespace mockturtle {
 
 class gia_network;
@@ -212,7 +214,8 @@ public:
     }
 
     pabc::Gia_Man_t * new_gia = pabc::Abc_FrameGetGia(abc);
-    pabc::Gia_ManStop(gia_);
+    /* gia_ may be a store entry with a cached level count */
+    MagicLS::release_gia(gia_);
     gia_ = new_gia;
     
     return success == 0;
@@ -0,0 +1,335 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file aiger_io.hpp
+ *
+ * @brief  Memory-mapped binary AIGER reader and streaming writer
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/12
+ */
+
+#ifndef AIGER_IO_HPP
+#define AIGER_IO_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <mockturtle/networks/aig.hpp>
+
+#include "./compressed_io.hpp"
+#include "./mapped_file.hpp"
+
+namespace MagicLS {
+
+namespace detail {
+
+class aiger_cursor {
+ public:
+  aiger_cursor(char const *begin, char const *end) : p_(begin), end_(end) {}
+
+  uint64_t number() {
+    while (p_ < end_ && *p_ == ' ') {
+      ++p_;
+    }
+    if (p_ == end_ || *p_ < '0' || *p_ > '9') {
+      throw std::runtime_error("malformed AIGER header");
+    }
+    uint64_t value = 0u;
+    while (p_ < end_ && *p_ >= '0' && *p_ <= '9') {
+      value = value * 10u + static_cast<uint64_t>(*p_++ - '0');
+    }
+    return value;
+  }
+
+  bool at_line_end() {
+    while (p_ < end_ && *p_ == ' ') {
+      ++p_;
+    }
+    return p_ == end_ || *p_ == '\n' || *p_ == '\r';
+  }
+
+  void next_line() {
+    while (p_ < end_ && *p_ != '\n') {
+      ++p_;
+    }
+    if (p_ < end_) {
+      ++p_;
+    }
+  }
+
+  /* 7-bit variable length encoding of the AND section */
+  uint64_t delta() {
+    uint64_t value = 0u;
+    uint32_t shift = 0u;
+    while (true) {
+      if (p_ == end_) {
+        throw std::runtime_error("truncated AIGER AND section");
+      }
+      const auto c = static_cast<unsigned char>(*p_++);
+      value |= static_cast<uint64_t>(c & 0x7f) << shift;
+      if (!(c & 0x80)) {
+        return value;
+      }
+      shift += 7u;
+    }
+  }
+
+  bool starts_with(char const *s) const {
+    auto q = p_;
+    for (; *s; ++s, ++q) {
+      if (q == end_ || *q != *s) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void skip(std::size_t n) { p_ += n; }
+
+ private:
+  char const *p_;
+  char const *end_;
+};
+
+}  // namespace detail
+
+/*! \brief Reads a combinational binary AIGER buffer into `aig`.
+ *
+ * The delta-encoded AND section is decoded in one pass.  With `strash` every AND goes through `create_and`.  Without it
+ * the nodes are appended to the AIG storage directly: binary AIGER is
+ * already topologically ordered and numbers its variables like mockturtle
+ * (constant, inputs, ANDs), so no literal map and no hash table lookups are
+ * needed, but structurally equivalent nodes are not merged.
+ *
+ * The AND section cannot be split without decoding it (the deltas have
+ * variable length), so decoding stays sequential; it is memory bound.
+ *
+ * Returns false, leaving `aig` untouched, for ASCII AIGER and files with
+ * latches or AIGER 1.9 sections, which the caller reads with lorina.
+ */
+inline bool read_binary_aiger(char const *data, std::size_t size,
+                              mockturtle::aig_network &aig, bool strash = true) {
+  using namespace mockturtle;
+  using signal = aig_network::signal;
+
+  detail::aiger_cursor c(data, data + size);
+  if (!c.starts_with("aig ")) {
+    return false;
+  }
+  c.skip(4u);
+
+  const auto num_vars = c.number();
+  const auto num_inputs = c.number();
+  const auto num_latches = c.number();
+  const auto num_outputs = c.number();
+  const auto num_ands = c.number();
+  if (num_latches != 0u) {
+    return false;
+  }
+  while (!c.at_line_end()) {
+    if (c.number() != 0u) {
+      return false; /* bad, constraint, justice or fairness properties */
+    }
+  }
+  c.next_line();
+  if (num_vars != num_inputs + num_ands) {
+    throw std::runtime_error("malformed AIGER header");
+  }
+
+  std::vector<uint64_t> outputs(num_outputs);
+  for (auto &o : outputs) {
+    o = c.number();
+    c.next_line();
+  }
+
+  for (auto const &o : outputs) {
+    if ((o >> 1) > num_vars) {
+      throw std::runtime_error("AIGER output literal out of range");
+    }
+  }
+  auto fanins = [&](uint64_t lhs) {
+    const auto d0 = c.delta();
+    const auto d1 = c.delta();
+    if (d0 == 0u || d0 > lhs || d1 > lhs - d0) {
+      throw std::runtime_error("malformed AIGER AND section");
+    }
+    return std::make_pair(lhs - d0, lhs - d0 - d1);
+  };
+
+  aig_network ntk;
+  for (auto i = 0u; i < num_inputs; ++i) {
+    ntk.create_pi();
+  }
+
+  if (strash) {
+    std::vector<signal> lits(num_vars + 1u);
+    lits[0] = ntk.get_constant(false);
+    for (auto i = 1u; i <= num_inputs; ++i) {
+      lits[i] = ntk.make_signal(ntk.pi_at(i - 1u));
+    }
+    auto lit_to_signal = [&](uint64_t lit) {
+      return (lit & 1u) ? ntk.create_not(lits[lit >> 1]) : lits[lit >> 1];
+    };
+    for (auto i = 0u; i < num_ands; ++i) {
+      const auto lhs = 2u * (num_inputs + i + 1u);
+      const auto [rhs0, rhs1] = fanins(lhs);
+      lits[lhs >> 1] = ntk.create_and(lit_to_signal(rhs0), lit_to_signal(rhs1));
+    }
+    for (auto const &o : outputs) {
+      ntk.create_po(lit_to_signal(o));
+    }
+  } else {
+    auto &st = *ntk._storage;
+    st.nodes.reserve(st.nodes.size() + num_ands);
+    for (auto i = 0u; i < num_ands; ++i) {
+      const auto lhs = 2u * (num_inputs + i + 1u);
+      const auto [rhs0, rhs1] = fanins(lhs);
+
+      /* same child order as create_and, rhs1 <= rhs0 */
+      typename std::decay_t<decltype(st.nodes)>::value_type node;
+      node.children[0] = signal(rhs1 >> 1, rhs1 & 1u);
+      node.children[1] = signal(rhs0 >> 1, rhs0 & 1u);
+      st.nodes.push_back(node);
+      st.nodes[rhs1 >> 1].data[0].h1++;
+      st.nodes[rhs0 >> 1].data[0].h1++;
+    }
+    for (auto const &o : outputs) {
+      ntk.create_po(signal(o >> 1, o & 1u));
+    }
+  }
+
+  aig = ntk;
+  return true;
+}
+
+/*! \brief Reads a binary AIGER file, memory mapped unless it is compressed. */
+inline bool read_binary_aiger(std::string const &filename,
+                              mockturtle::aig_network &aig, bool strash = true) {
+  if (compression_of(filename) != compression::none) {
+    const auto contents = read_file_contents(filename);
+    return read_binary_aiger(contents.data(), contents.size(), aig, strash);
+  }
+  mapped_file file(filename);
+  return read_binary_aiger(file.data(), file.size(), aig, strash);
+}
+
+/*! \brief Writes `aig` as binary AIGER through a fixed-size buffer.
+ *
+ * Variables are renumbered (inputs first, gates in topological order), the
+ * AND section is encoded on the fly, so memory stays constant in the size
+ * of the network apart from the variable map.
+ */
+inline void write_binary_aiger(mockturtle::aig_network const &aig,
+                               std::ostream &os) {
+  using node = mockturtle::aig_network::node;
+
+  /* node indexes are not topological after in-place substitutions, so the
+   * gates are ordered by an iterative depth-first search */
+  std::vector<node> gates;
+  gates.reserve(aig.num_gates());
+  {
+    std::vector<uint8_t> state(aig.size(), 0u); /* 1 on stack, 2 placed */
+    std::vector<std::pair<node, bool>> stack;
+    aig.foreach_gate([&](auto const &root) {
+      stack.emplace_back(root, false);
+      while (!stack.empty()) {
+        auto [n, expanded] = stack.back();
+        stack.pop_back();
+        const auto index = aig.node_to_index(n);
+        if (expanded) {
+          state[index] = 2u;
+          gates.push_back(n);
+          continue;
+        }
+        if (state[index] != 0u || !aig.is_and(n)) {
+          continue;
+        }
+        state[index] = 1u;
+        stack.emplace_back(n, true);
+        aig.foreach_fanin(n, [&](auto const &f) {
+          if (state[aig.node_to_index(aig.get_node(f))] == 0u) {
+            stack.emplace_back(aig.get_node(f), false);
+          }
+        });
+      }
+    });
+  }
+
+  std::vector<uint64_t> var(aig.size(), 0u);
+  uint64_t num_vars = 0u;
+  aig.foreach_pi([&](auto const &n) { var[aig.node_to_index(n)] = ++num_vars; });
+  const auto num_inputs = num_vars;
+  for (auto const &n : gates) {
+    var[aig.node_to_index(n)] = ++num_vars;
+  }
+
+  auto lit = [&](mockturtle::aig_network::signal const &f) {
+    return 2u * var[aig.node_to_index(aig.get_node(f))] +
+           (aig.is_complemented(f) ? 1u : 0u);
+  };
+
+  std::vector<char> buffer;
+  buffer.reserve(1u << 20);
+  auto flush = [&]() {
+    os.write(buffer.data(), buffer.size());
+    buffer.clear();
+  };
+  auto put_string = [&](std::string const &s) {
+    buffer.insert(buffer.end(), s.begin(), s.end());
+    if (buffer.size() >= (1u << 20) - 64u) {
+      flush();
+    }
+  };
+  auto put_delta = [&](uint64_t x) {
+    while (x & ~uint64_t(0x7f)) {
+      buffer.push_back(static_cast<char>((x & 0x7f) | 0x80));
+      x >>= 7;
+    }
+    buffer.push_back(static_cast<char>(x));
+    if (buffer.size() >= (1u << 20) - 64u) {
+      flush();
+    }
+  };
+
+  put_string("aig " + std::to_string(num_vars) + " " + std::to_string(num_inputs) +
+             " 0 " + std::to_string(aig.num_pos()) + " " +
+             std::to_string(num_vars - num_inputs) + "\n");
+  aig.foreach_po([&](auto const &f) { put_string(std::to_string(lit(f)) + "\n"); });
+
+  for (auto const &n : gates) {
+    const auto lhs = 2u * var[aig.node_to_index(n)];
+    uint64_t rhs0 = 0u, rhs1 = 0u;
+    aig.foreach_fanin(n, [&](auto const &f, auto i) {
+      (i == 0 ? rhs0 : rhs1) = lit(f);
+    });
+    if (rhs0 < rhs1) {
+      std::swap(rhs0, rhs1);
+    }
+    if (lhs <= rhs0) {
+      throw std::logic_error("AIGER writer: the AIG is cyclic");
+    }
+    put_delta(lhs - rhs0);
+    put_delta(rhs0 - rhs1);
+  }
+
+  put_string("c\nMagicLS\n");
+  flush();
+}
+
+/* Writes to `filename`, compressed if its extension asks for it. */
+inline void write_binary_aiger(mockturtle::aig_network const &aig,
+                               std::string const &filename) {
+  detail::with_output(filename,
+                      [&](std::ostream &os) { write_binary_aiger(aig, os); });
+}
+
+}  // namespace MagicLS
+
+#endif
@@ -18,6 +18,9 @@
 #include <deque>
 #include <list>
 #include <stack>
+#include <algorithm>
+#include <cmath>
+#include <string>
 
 #include <kitty/kitty.hpp>
 #include <mockturtle/mockturtle.hpp>
@@ -86,6 +89,10 @@ namespace mockturtle
             borrow = a_ext[a.size()];
         }
 
+        /* MIG and XMG implement the majority gate natively */
+        template <typename Ntk>
+        inline constexpr bool is_maj_native_v = std::is_same_v<typename Ntk::base_type, mig_network> || std::is_same_v<typename Ntk::base_type, xmg_network>;
+
         /* The processing module for generate signal and propagate signal */
         template <typename Ntk>
         class PG
@@ -100,8 +107,19 @@ namespace mockturtle
 
             void o_operation(Ntk &ntk, PG const &other)
             {
-                this->g = ntk.create_or(this->g, ntk.create_and(this->p, other.g));
-                this->p = ntk.create_and(this->p, other.p);
+                if constexpr (is_maj_native_v<Ntk>)
+                {
+                    /* If g implies p (OR-propagate, see propagate()), then g + p*g' = MAJ(g, p, g')
+                     * and g + p*p' = MAJ(g, p, p') is a valid group propagate that keeps g => p. */
+                    const auto g_new = ntk.create_maj(this->g, this->p, other.g);
+                    this->p = ntk.create_maj(this->g, this->p, other.p);
+                    this->g = g_new;
+                }
+                else
+                {
+                    this->g = ntk.create_or(this->g, ntk.create_and(this->p, other.g));
+                    this->p = ntk.create_and(this->p, other.p);
+                }
                 assert(this->begin >= other.begin);
                 this->end = other.end;
             }
@@ -111,6 +129,41 @@ namespace mockturtle
             uint32_t end;
         };
 
+        /* Propagate signal of the prefix tree: XOR, or OR for majority-native networks (the MAJ operator needs g => p). */
+        template <typename Ntk>
+        inline signal<Ntk> propagate(Ntk &ntk, signal<Ntk> const &a, signal<Ntk> const &b)
+        {
+            if constexpr (is_maj_native_v<Ntk>)
+            {
+                return ntk.create_or(a, b);
+            }
+            else
+            {
+                return ntk.create_xor(a, b);
+            }
+        }
+
+        /* Group for the incoming carry, its propagate equals the carry for majority-native networks to keep g => p. */
+        template <typename Ntk>
+        inline PG<Ntk> carry_in_pg(Ntk &ntk, signal<Ntk> const &carry, uint32_t bit_width)
+        {
+            return PG<Ntk>(carry, is_maj_native_v<Ntk> ? carry : ntk.get_constant(false), bit_width, 0);
+        }
+
+        /* Sum bit a ^ b ^ c, a single XOR3 if the network has it */
+        template <typename Ntk>
+        inline signal<Ntk> sum_bit(Ntk &ntk, signal<Ntk> const &a, signal<Ntk> const &b, signal<Ntk> const &c)
+        {
+            if constexpr (is_maj_native_v<Ntk> && has_create_xor3_v<Ntk>)
+            {
+                return ntk.create_xor3(a, b, c);
+            }
+            else
+            {
+                return ntk.create_xor(ntk.create_xor(a, b), c);
+            }
+        }
+
         /*! \brief Creates brent-kung subtractor structure.
          *
          * Creates a brent-kung structure composed of full subtractors.  The vectors `a`
@@ -125,15 +178,13 @@ namespace mockturtle
         template <typename Ntk>
         inline void brent_kung_subtractor_inplace(Ntk &ntk, std::vector<signal<Ntk>> &a, std::vector<signal<Ntk>> const &b, signal<Ntk> &borrow)
         {
-            std::vector<signal<Ntk>> gen(a.size()), pro(a.size()), pro2(a.size()), bor(a.size() + 1);
+            std::vector<signal<Ntk>> gen(a.size()), pro(a.size()), bor(a.size() + 1);
             bor[0] = borrow;
             std::transform(a.begin(), a.end(), b.begin(), gen.begin(), [&](auto const &f, auto const &g)
                            { return ntk.create_and(ntk.create_not(f), g); });
             // std::transform( a.begin(), a.end(), b.begin(), pro.begin(), [&]( auto const& f, auto const& g ) { return ntk.create_xor( ntk.create_not( f ), g ); } );
             std::transform(a.begin(), a.end(), b.begin(), pro.begin(), [&](auto const &f, auto const &g)
                            { return ntk.create_or(ntk.create_not(f), g); });
-            std::transform(a.begin(), a.end(), b.begin(), pro2.begin(), [&](auto const &f, auto const &g)
-                           { return ntk.create_xor(f, g); });
 
             std::vector<PG<Ntk>> pg;
             std::vector<PG<Ntk> *> pg_ptr;
@@ -205,8 +256,10 @@ namespace mockturtle
             }
 
             // carry_lookahead_adder_inplace_rec( ntk, gen.begin(), gen.end(), pro.begin(), bor.begin() );
-            std::transform(pro2.begin(), pro2.end(), bor.begin(), a.begin(), [&](auto const &f, auto const &g)
-                           { return ntk.create_xor(f, g); });
+            for (auto i = 0u; i < a.size(); i++)
+            {
+                a[i] = sum_bit(ntk, a[i], b[i], bor[i]);
+            }
             borrow = bor.back();
 
             for_each(pg_ptr.begin(), pg_ptr.end(), [&](auto &pg)
@@ -225,14 +278,12 @@ namespace mockturtle
         template <typename Ntk>
         inline void brent_kung_adder_inplace(Ntk &ntk, std::vector<signal<Ntk>> &a, std::vector<signal<Ntk>> const &b, signal<Ntk> &carry)
         {
-            std::vector<signal<Ntk>> gen(a.size()), pro(a.size()), pro2(a.size()), bor(a.size() + 1);
+            std::vector<signal<Ntk>> gen(a.size()), pro(a.size()), bor(a.size() + 1);
             bor[0] = carry;
             std::transform(a.begin(), a.end(), b.begin(), gen.begin(), [&](auto const &f, auto const &g)
                            { return ntk.create_and(f, g); });
             std::transform(a.begin(), a.end(), b.begin(), pro.begin(), [&](auto const &f, auto const &g)
-                           { return ntk.create_xor(f, g); });
-            std::transform(a.begin(), a.end(), b.begin(), pro2.begin(), [&](auto const &f, auto const &g)
-                           { return ntk.create_xor(f, g); });
+                           { return propagate(ntk, f, g); });
 
             std::vector<PG<Ntk>> pg;
             std::vector<PG<Ntk> *> pg_ptr;
@@ -244,7 +295,7 @@ namespace mockturtle
             }
 
             /* This section is used if there is a special carry (equal to 1), which defaults to 0 */
-            PG<Ntk> pg0(carry, ntk.get_constant(false), a.size(), 0);
+            PG<Ntk> pg0 = carry_in_pg(ntk, carry, a.size());
             pg[0].o_operation(ntk, pg0);
 
             /* The first round of carry generation */
@@ -303,8 +354,10 @@ namespace mockturtle
                 bor[i] = pg[i - 1].g;
             }
 
-            std::transform(pro2.begin(), pro2.end(), bor.begin(), a.begin(), [&](auto const &f, auto const &g)
-                           { return ntk.create_xor(f, g); });
+            for (auto i = 0u; i < a.size(); i++)
+            {
+                a[i] = sum_bit(ntk, a[i], b[i], bor[i]);
+            }
             carry = bor.back();
 
             for_each(pg_ptr.begin(), pg_ptr.end(), [&](auto &pg)
@@ -325,15 +378,13 @@ namespace mockturtle
         template <typename Ntk>
         inline void kogge_stone_subtractor_inplace(Ntk &ntk, std::vector<signal<Ntk>> &a, std::vector<signal<Ntk>> const &b, signal<Ntk> &borrow)
         {
-            std::vector<signal<Ntk>> gen(a.size()), pro(a.size()), pro2(a.size()), bor(a.size() + 1);
+            std::vector<signal<Ntk>> gen(a.size()), pro(a.size()), bor(a.size() + 1);
             bor[0] = borrow;
             std::transform(a.begin(), a.end(), b.begin(), gen.begin(), [&](auto const &f, auto const &g)
                            { return ntk.create_and(ntk.create_not(f), g); });
             // std::transform( a.begin(), a.end(), b.begin(), pro.begin(), [&]( auto const& f, auto const& g ) { return ntk.create_xor( ntk.create_not( f ), g ); } );
             std::transform(a.begin(), a.end(), b.begin(), pro.begin(), [&](auto const &f, auto const &g)
                            { return ntk.create_or(ntk.create_not(f), g); });
-            std::transform(a.begin(), a.end(), b.begin(), pro2.begin(), [&](auto const &f, auto const &g)
-                           { return ntk.create_xor(f, g); });
 
             std::vector<PG<Ntk>> pg;
             std::vector<PG<Ntk> *> pg_ptr;
@@ -345,7 +396,7 @@ namespace mockturtle
             }
 
             /* This section is used if there is a special borrow, which defaults to 0 */
-            PG<Ntk> pg0(borrow, ntk.get_constant(false), a.size(), 0);
+            PG<Ntk> pg0 = carry_in_pg(ntk, borrow, a.size());
             pg[0].o_operation(ntk, pg0);
 
             /* The first round of carry generation */
@@ -367,8 +418,10 @@ namespace mockturtle
                 bor[i] = pg[i - 1].g;
             }
 
-            std::transform(pro2.begin(), pro2.end(), bor.begin(), a.begin(), [&](auto const &f, auto const &g)
-                           { return ntk.create_xor(f, g); });
+            for (auto i = 0u; i < a.size(); i++)
+            {
+                a[i] = sum_bit(ntk, a[i], b[i], bor[i]);
+            }
             borrow = bor.back();
 
             for_each(pg_ptr.begin(), pg_ptr.end(), [&](auto &pg)
@@ -389,14 +442,12 @@ namespace mockturtle
         template <typename Ntk>
         inline void kogge_stone_adder_inplace(Ntk &ntk, std::vector<signal<Ntk>> &a, std::vector<signal<Ntk>> const &b, signal<Ntk> &carry)
         {
-            std::vector<signal<Ntk>> gen(a.size()), pro(a.size()), pro2(a.size()), bor(a.size() + 1);
+            std::vector<signal<Ntk>> gen(a.size()), pro(a.size()), bor(a.size() + 1);
             bor[0] = carry;
             std::transform(a.begin(), a.end(), b.begin(), gen.begin(), [&](auto const &f, auto const &g)
                            { return ntk.create_and(f, g); });
             std::transform(a.begin(), a.end(), b.begin(), pro.begin(), [&](auto const &f, auto const &g)
-                           { return ntk.create_xor(f, g); });
-            std::transform(a.begin(), a.end(), b.begin(), pro2.begin(), [&](auto const &f, auto const &g)
-                           { return ntk.create_xor(f, g); }); // what?
+                           { return propagate(ntk, f, g); });
 
             std::vector<PG<Ntk>> pg;
             std::vector<PG<Ntk> *> pg_ptr;
@@ -408,7 +459,7 @@ namespace mockturtle
             }
 
             /* This section is used if there is a special carry, which defaults to 0 */
-            PG<Ntk> pg0(carry, ntk.get_constant(false), a.size(), 0);
+            PG<Ntk> pg0 = carry_in_pg(ntk, carry, a.size());
             pg[0].o_operation(ntk, pg0);
 
             /* The first round of carry generation */
@@ -430,8 +481,10 @@ namespace mockturtle
                 bor[i] = pg[i - 1].g;
             }
 
-            std::transform(pro2.begin(), pro2.end(), bor.begin(), a.begin(), [&](auto const &f, auto const &g)
-                           { return ntk.create_xor(f, g); });
+            for (auto i = 0u; i < a.size(); i++)
+            {
+                a[i] = sum_bit(ntk, a[i], b[i], bor[i]);
+            }
             carry = bor.back();
 
             for_each(pg_ptr.begin(), pg_ptr.end(), [&](auto &pg)
@@ -459,15 +512,13 @@ namespace mockturtle
                 return;
             }
 
-            std::vector<signal<Ntk>> gen(a.size()), pro(a.size()), pro2(a.size()), bor(a.size() + 1);
+            std::vector<signal<Ntk>> gen(a.size()), pro(a.size()), bor(a.size() + 1);
             bor[0] = borrow;
             std::transform(a.begin(), a.end(), b.begin(), gen.begin(), [&](auto const &f, auto const &g)
                            { return ntk.create_and(ntk.create_not(f), g); });
             // std::transform( a.begin(), a.end(), b.begin(), pro.begin(), [&]( auto const& f, auto const& g ) { return ntk.create_xor( ntk.create_not( f ), g ); } );
             std::transform(a.begin(), a.end(), b.begin(), pro.begin(), [&](auto const &f, auto const &g)
                            { return ntk.create_or(ntk.create_not(f), g); });
-            std::transform(a.begin(), a.end(), b.begin(), pro2.begin(), [&](auto const &f, auto const &g)
-                           { return ntk.create_xor(f, g); });
 
             std::vector<PG<Ntk>> pg;
             std::vector<PG<Ntk> *> pg_ptr;
@@ -585,8 +636,10 @@ namespace mockturtle
                 bor[i] = pg[i - 1].g;
             }
 
-            std::transform(pro2.begin(), pro2.end(), bor.begin(), a.begin(), [&](auto const &f, auto const &g)
-                           { return ntk.create_xor(f, g); });
+            for (auto i = 0u; i < a.size(); i++)
+            {
+                a[i] = sum_bit(ntk, a[i], b[i], bor[i]);
+            }
             borrow = bor.back();
 
             for_each(pg_ptr.begin(), pg_ptr.end(), [&](auto &pg)
@@ -614,14 +667,12 @@ namespace mockturtle
                 return;
             }
 
-            std::vector<signal<Ntk>> gen(a.size()), pro(a.size()), pro2(a.size()), bor(a.size() + 1);
+            std::vector<signal<Ntk>> gen(a.size()), pro(a.size()), bor(a.size() + 1);
             bor[0] = carry;
             std::transform(a.begin(), a.end(), b.begin(), gen.begin(), [&](auto const &f, auto const &g)
                            { return ntk.create_and(f, g); });
             std::transform(a.begin(), a.end(), b.begin(), pro.begin(), [&](auto const &f, auto const &g)
-                           { return ntk.create_xor(f, g); });
-            std::transform(a.begin(), a.end(), b.begin(), pro2.begin(), [&](auto const &f, auto const &g)
-                           { return ntk.create_xor(f, g); });
+                           { return propagate(ntk, f, g); });
 
             std::vector<PG<Ntk>> pg;
             std::vector<PG<Ntk> *> pg_ptr;
@@ -710,8 +761,10 @@ namespace mockturtle
             }
 
             // carry_lookahead_adder_inplace_rec( ntk, gen.begin(), gen.end(), pro.begin(), bor.begin() );
-            std::transform(pro2.begin(), pro2.end(), bor.begin(), a.begin(), [&](auto const &f, auto const &g)
-                           { return ntk.create_xor(f, g); });
+            for (auto i = 0u; i < a.size(); i++)
+            {
+                a[i] = sum_bit(ntk, a[i], b[i], bor[i]);
+            }
             carry = bor.back();
             for_each(pg_ptr.begin(), pg_ptr.end(), [&](auto &pg)
                      { delete pg; });
@@ -725,8 +778,9 @@ namespace mockturtle
      *
      * By default creates a seven 2-input gate network composed of AND, NOR, and OR
      * gates.  If network has `create_node` function, creates two 3-input gate
-     * network.  If the network has ternary `create_maj` and `create_xor3`
-     * functions, it will use them (except for AIGs).
+     * network.  MIGs and XMGs (and any other network with ternary `create_maj`
+     * and `create_xor3` functions, except for AIGs) compute the borrow with a
+     * single majority gate, and the difference with XOR3 if available.
      *
      * \param ntk Network
      * \param a First input operand
@@ -752,11 +806,19 @@ namespace mockturtle
             return {difference, borrow};
         }
         /* use MAJ and XOR3 if available by network, unless network is AIG */
-        else if constexpr (!std::is_same_v<typename Ntk::base_type, aig_network> && has_create_maj_v<Ntk> && has_create_xor3_v<Ntk>)
+        else if constexpr (detail::is_maj_native_v<Ntk> || (!std::is_same_v<typename Ntk::base_type, aig_network> && has_create_maj_v<Ntk> && has_create_xor3_v<Ntk>))
         {
             const auto borrow = ntk.create_maj(!a, b, c);
-            const auto difference = ntk.create_xor3(a, b, c);
-            return {difference, borrow};
+            if constexpr (has_create_xor3_v<Ntk>)
+            {
+                const auto difference = ntk.create_xor3(a, b, c);
+                return {difference, borrow};
+            }
+            else
+            {
+                const auto difference = ntk.create_xor(ntk.create_xor(a, b), c);
+                return {difference, borrow};
+            }
         }
         else
         {
@@ -1097,6 +1159,211 @@ namespace mockturtle
         // return partial_product[0];
     }
 
+    namespace detail
+    {
+        /*! \brief Reduces a bit matrix to two rows with a compressor tree.
+         *
+         * `columns[i]` holds all bits of weight 2^i.  Every stage compresses each
+         * column with 4:2 compressors (two chained full adders, the cout of the
+         * first one feeds the cin of the next column in the same stage) and 3:2
+         * compressors (full adders) until every column has at most two bits.
+         * Carries out of the last column are dropped.
+         *
+         * \param columns Bit matrix, will have at most two bits per column after the call
+         * \param use_4_2 Use 4:2 compressors, otherwise a pure 3:2 (Wallace) tree
+         */
+        template <typename Ntk>
+        inline void compressor_tree_inplace(Ntk &ntk, std::vector<std::vector<signal<Ntk>>> &columns, bool use_4_2 = true)
+        {
+            const auto width = columns.size();
+            auto too_high = [&]()
+            {
+                return std::any_of(columns.begin(), columns.end(), [](auto const &col)
+                                   { return col.size() > 2u; });
+            };
+
+            while (too_high())
+            {
+                std::vector<std::vector<signal<Ntk>>> next(width), cins(width + 1);
+                for (auto i = 0u; i < width; ++i)
+                {
+                    auto const &bits = columns[i];
+                    auto pos = 0u;
+                    auto push_carry = [&](signal<Ntk> const &c)
+                    {
+                        if (i + 1 < width)
+                        {
+                            next[i + 1].push_back(c);
+                        }
+                    };
+
+                    /* 4:2 compressors, the horizontal cout does not depend on cin */
+                    while (use_4_2 && bits.size() - pos >= 4u)
+                    {
+                        auto [s1, cout] = full_adder(ntk, bits[pos], bits[pos + 1], bits[pos + 2]);
+                        if (i + 1 < width)
+                        {
+                            cins[i + 1].push_back(cout);
+                        }
+                        if (cins[i].empty())
+                        {
+                            auto [sum, carry] = half_adder(ntk, s1, bits[pos + 3]);
+                            next[i].push_back(sum);
+                            push_carry(carry);
+                        }
+                        else
+                        {
+                            auto [sum, carry] = full_adder(ntk, s1, bits[pos + 3], cins[i].back());
+                            cins[i].pop_back();
+                            next[i].push_back(sum);
+                            push_carry(carry);
+                        }
+                        pos += 4u;
+                    }
+
+                    /* 3:2 compressors */
+                    while (bits.size() - pos >= 3u)
+                    {
+                        auto [sum, carry] = full_adder(ntk, bits[pos], bits[pos + 1], bits[pos + 2]);
+                        next[i].push_back(sum);
+                        push_carry(carry);
+                        pos += 3u;
+                    }
+
+                    /* left-over bits and unused cins move on to the next stage */
+                    next[i].insert(next[i].end(), bits.begin() + pos, bits.end());
+                    next[i].insert(next[i].end(), cins[i].begin(), cins[i].end());
+                }
+                columns = next;
+            }
+        }
+
+        /* Sums the two rows of a reduced bit matrix with the prefix adder `func`. */
+        template <typename Ntk>
+        inline std::vector<signal<Ntk>> final_adder(Ntk &ntk, std::vector<std::vector<signal<Ntk>>> const &columns, void (*func)(Ntk &, std::vector<signal<Ntk>> &, std::vector<signal<Ntk>> const &, signal<Ntk> &))
+        {
+            std::vector<signal<Ntk>> row0(columns.size(), ntk.get_constant(false)), row1(columns.size(), ntk.get_constant(false));
+            for (auto i = 0u; i < columns.size(); ++i)
+            {
+                assert(columns[i].size() <= 2u);
+                if (columns[i].size() > 0u)
+                    row0[i] = columns[i][0];
+                if (columns[i].size() > 1u)
+                    row1[i] = columns[i][1];
+            }
+
+            signal<Ntk> carry = ntk.get_constant(false);
+            func(ntk, row0, row1, carry);
+            return row0;
+        }
+    } // namespace detail
+
+    /*! \brief Creates a multi-operand adder.
+     *
+     * All operands are summed by one 4:2/3:2 compressor tree followed by a
+     * single prefix adder `func`, instead of one carry-propagate adder per
+     * operand.  The operands may have different sizes, the result has
+     * `max_size + ceil(log2(#operands))` bits so that it cannot overflow.
+     *
+     * \param operands Operands, least significant bit first
+     * \param func Final adder, e.g. `detail::han_carlson_adder_inplace`
+     * \param use_4_2 Use 4:2 compressors in the tree [default = yes]
+     */
+    template <typename Ntk>
+    inline std::vector<signal<Ntk>> multi_operand_adder(Ntk &ntk, std::vector<std::vector<signal<Ntk>>> const &operands, void (*func)(Ntk &, std::vector<signal<Ntk>> &, std::vector<signal<Ntk>> const &, signal<Ntk> &), bool use_4_2 = true)
+    {
+        static_assert(is_network_type_v<Ntk>, "Ntk is not a network type");
+        static_assert(has_create_and_v<Ntk>, "Ntk does not implement the create_and method");
+        static_assert(has_create_xor_v<Ntk>, "Ntk does not implement the create_xor method");
+        static_assert(has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method");
+
+        if (operands.empty())
+        {
+            return {};
+        }
+
+        std::size_t max_size = 0u;
+        for (auto const &op : operands)
+        {
+            max_size = std::max(max_size, op.size());
+        }
+        const auto width = max_size + static_cast<uint32_t>(std::ceil(std::log2(static_cast<double>(operands.size()))));
+
+        std::vector<std::vector<signal<Ntk>>> columns(width);
+        for (auto const &op : operands)
+        {
+            for (auto i = 0u; i < op.size(); ++i)
+            {
+                columns[i].push_back(op[i]);
+            }
+        }
+
+        detail::compressor_tree_inplace(ntk, columns, use_4_2);
+        return detail::final_adder(ntk, columns, func);
+    }
+
+    /*! \brief Creates a fused multiply-add `a * b + c`.
+     *
+     * The addend `c` is merged as one more row into the partial-product matrix
+     * of `a * b`, so the whole expression is reduced by one compressor tree and
+     * one final prefix adder `func`.  With an empty `c` this is a compressor
+     * tree multiplier of `a.size() + b.size()` bits, otherwise the result has
+     * `max(a.size() + b.size(), c.size()) + 1` bits.
+     *
+     * \param a Multiplicand
+     * \param b Multiplier
+     * \param c Addend (may be empty)
+     * \param func Final adder, e.g. `detail::han_carlson_adder_inplace`
+     * \param use_4_2 Use 4:2 compressors in the tree [default = yes]
+     */
+    template <typename Ntk>
+    inline std::vector<signal<Ntk>> fused_multiply_add(Ntk &ntk, std::vector<signal<Ntk>> const &a, std::vector<signal<Ntk>> const &b, std::vector<signal<Ntk>> const &c, void (*func)(Ntk &, std::vector<signal<Ntk>> &, std::vector<signal<Ntk>> const &, signal<Ntk> &), bool use_4_2 = true)
+    {
+        static_assert(is_network_type_v<Ntk>, "Ntk is not a network type");
+        static_assert(has_create_and_v<Ntk>, "Ntk does not implement the create_and method");
+        static_assert(has_create_xor_v<Ntk>, "Ntk does not implement the create_xor method");
+        static_assert(has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method");
+
+        const auto width = std::max(a.size() + b.size(), c.size()) + (c.empty() ? 0u : 1u);
+
+        std::vector<std::vector<signal<Ntk>>> columns(width);
+
+        // partial_product generation, a[i] * b[j] has weight 2^(i+j)
+        for (auto j = 0u; j < b.size(); ++j)
+        {
+            for (auto i = 0u; i < a.size(); ++i)
+            {
+                columns[i + j].push_back(ntk.create_and(a[i], b[j]));
+            }
+        }
+
+        // the addend is one more row of the matrix
+        for (auto i = 0u; i < c.size(); ++i)
+        {
+            columns[i].push_back(c[i]);
+        }
+
+        detail::compressor_tree_inplace(ntk, columns, use_4_2);
+        return detail::final_adder(ntk, columns, func);
+    }
+
+    /*! \brief Returns the in-place prefix adder with the given name.
+     *
+     * Accepts the names used by the generator commands: `brent-kung`,
+     * `kogge-stone` and `han-carlson`.  Returns `nullptr` for unknown names.
+     */
+    template <typename Ntk>
+    inline auto prefix_adder_by_name(std::string const &name) -> void (*)(Ntk &, std::vector<signal<Ntk>> &, std::vector<signal<Ntk>> const &, signal<Ntk> &)
+    {
+        if (name == "brent-kung")
+            return detail::brent_kung_adder_inplace<Ntk>;
+        if (name == "kogge-stone")
+            return detail::kogge_stone_adder_inplace<Ntk>;
+        if (name == "han-carlson")
+            return detail::han_carlson_adder_inplace<Ntk>;
+        return nullptr;
+    }
+
 } // namespace mockturtle
 
 #endif
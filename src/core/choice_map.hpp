@@ -0,0 +1,186 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file choice_map.hpp
+ *
+ * @brief  Structural choices over output partitions and mapping with them
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/21
+ */
+
+#ifndef CHOICE_MAP_HPP
+#define CHOICE_MAP_HPP
+
+#include <base/abc/abc.h>
+#include <base/main/main.h>
+#include <proof/dch/dch.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <mockturtle/networks/klut.hpp>
+
+#include "./abc_api.hpp"
+#include "./thread_pool.hpp"
+
+namespace pabc {
+Abc_Ntk_t * Abc_NtkDch( Abc_Ntk_t * pNtk, Dch_Pars_t * pPars );
+}
+
+namespace MagicLS {
+
+/*! \brief Strashed cones of consecutive output ranges.
+ *
+ * Every cone keeps all CIs of `pNtk` in their order, so the partitions can
+ * be stitched back by CI index; `outputs[p]` lists the CO indexes of `pNtk`
+ * driven by the COs of cone `p`.
+ */
+struct output_partition {
+  std::vector<pabc::Abc_Ntk_t *> cones;
+  std::vector<std::vector<int>> outputs;
+};
+
+inline output_partition partition_outputs(pabc::Abc_Ntk_t *pNtk,
+                                          uint32_t num_parts) {
+  const auto num_cos = static_cast<uint32_t>(pabc::Abc_NtkCoNum(pNtk));
+  num_parts = std::clamp(num_parts, 1u, std::max(num_cos, 1u));
+
+  output_partition part;
+  for (auto p = 0u; p < num_parts; ++p) {
+    const auto first = num_cos * p / num_parts;
+    const auto last = num_cos * (p + 1u) / num_parts;
+
+    pabc::Vec_Ptr_t *vRoots = pabc::Vec_PtrAlloc(last - first);
+    std::vector<int> outputs;
+    for (auto i = first; i < last; ++i) {
+      pabc::Vec_PtrPush(vRoots, pabc::Abc_NtkCo(pNtk, i));
+      outputs.push_back(static_cast<int>(i));
+    }
+    part.cones.push_back(pabc::Abc_NtkCreateConeArray(pNtk, vRoots, 1));
+    part.outputs.push_back(std::move(outputs));
+    pabc::Vec_PtrFree(vRoots);
+  }
+  return part;
+}
+
+/*! \brief Computes choices on every cone, one cone at a time.
+ *
+ * `Abc_NtkDch` runs DAR rewriting and balancing, which use process-wide
+ * state such as the static rewriting library, so separate managers do not
+ * make it reentrant; the calls hold `abc_mutex()` and cannot overlap.
+ * Every cone gets its own copy of the parameters, `Abc_NtkDch` records run
+ * times in them.  Returns nullptr entries for failed cones.
+ */
+inline std::vector<pabc::Abc_Ntk_t *> compute_choices(
+    std::vector<pabc::Abc_Ntk_t *> const &cones, pabc::Dch_Pars_t const &pars) {
+  std::lock_guard<std::mutex> lock(abc_mutex());
+  std::vector<pabc::Abc_Ntk_t *> result;
+  for (auto *cone : cones) {
+    auto p = pars;
+    result.push_back(pabc::Abc_NtkDch(cone, &p));
+  }
+  return result;
+}
+
+/* Joins standard-cell mapped cones into one mapped network. */
+inline pabc::Abc_Ntk_t *stitch_mapped(pabc::Abc_Ntk_t *pNtk,
+                                      std::vector<pabc::Abc_Ntk_t *> const &parts,
+                                      std::vector<std::vector<int>> const &outputs) {
+  using namespace pabc; /* the iteration macros use unqualified names */
+  Abc_Ntk_t *pNew = Abc_NtkAlloc(ABC_NTK_LOGIC, ABC_FUNC_MAP, 1);
+  pNew->pName = Extra_UtilStrsav(Abc_NtkName(pNtk));
+  Abc_Obj_t *pObj, *pFanin;
+  int i, k;
+
+  Abc_NtkForEachCi(pNtk, pObj, i) {
+    Abc_ObjAssignName(Abc_NtkCreatePi(pNew), Abc_ObjName(pObj), NULL);
+  }
+
+  std::vector<Abc_Obj_t *> drivers(Abc_NtkCoNum(pNtk), nullptr);
+  for (auto p = 0u; p < parts.size(); ++p) {
+    Abc_Ntk_t *pPart = parts[p];
+    Abc_NtkCleanCopy(pPart);
+    Abc_NtkForEachCi(pPart, pObj, i) { pObj->pCopy = Abc_NtkCi(pNew, i); }
+
+    Vec_Ptr_t *vNodes = Abc_NtkDfs(pPart, 0);
+    Vec_PtrForEachEntry(Abc_Obj_t *, vNodes, pObj, i) {
+      Abc_NtkDupObj(pNew, pObj, 0);
+      Abc_ObjForEachFanin(pObj, pFanin, k) {
+        Abc_ObjAddFanin(pObj->pCopy, pFanin->pCopy);
+      }
+    }
+    Vec_PtrFree(vNodes);
+
+    Abc_NtkForEachCo(pPart, pObj, i) {
+      drivers[outputs[p][i]] = Abc_ObjFanin0(pObj)->pCopy;
+    }
+  }
+
+  Abc_NtkForEachCo(pNtk, pObj, i) {
+    Abc_Obj_t *pPo = Abc_NtkCreatePo(pNew);
+    Abc_ObjAddFanin(pPo, drivers[i]);
+    Abc_ObjAssignName(pPo, Abc_ObjName(pObj), NULL);
+  }
+  if (!Abc_NtkCheck(pNew)) {
+    Abc_Print(-1, "The stitched mapped network has failed the check.\n");
+  }
+  return pNew;
+}
+
+/* Joins k-LUT networks of the cones into one network. */
+inline mockturtle::klut_network stitch_klut(
+    uint32_t num_cis, uint32_t num_cos,
+    std::vector<mockturtle::klut_network> const &parts,
+    std::vector<std::vector<int>> const &outputs) {
+  using signal = mockturtle::klut_network::signal;
+
+  mockturtle::klut_network klut;
+  std::vector<signal> pis;
+  for (auto i = 0u; i < num_cis; ++i) {
+    pis.push_back(klut.create_pi());
+  }
+
+  std::vector<signal> drivers(num_cos, klut.get_constant(false));
+  for (auto p = 0u; p < parts.size(); ++p) {
+    auto const &part = parts[p];
+    std::vector<signal> old2new(part.size());
+    old2new[part.node_to_index(part.get_node(part.get_constant(false)))] =
+        klut.get_constant(false);
+    old2new[part.node_to_index(part.get_node(part.get_constant(true)))] =
+        klut.get_constant(true);
+    part.foreach_pi([&](auto const &n, auto i) { old2new[part.node_to_index(n)] = pis[i]; });
+
+    /* nodes are created in topological order */
+    part.foreach_gate([&](auto const &n) {
+      std::vector<signal> children;
+      part.foreach_fanin(n, [&](auto const &f) {
+        children.push_back(old2new[part.node_to_index(part.get_node(f))]);
+      });
+      old2new[part.node_to_index(n)] = klut.create_node(children, part.node_function(n));
+    });
+    part.foreach_po([&](auto const &f, auto i) {
+      drivers[outputs[p][i]] = old2new[part.node_to_index(part.get_node(f))];
+    });
+  }
+
+  for (auto const &d : drivers) {
+    klut.create_po(d);
+  }
+  return klut;
+}
+
+/* AIG with choices as a GIA with sibling pointers, for `&if`. */
+inline pabc::Gia_Man_t *choices_to_gia(pabc::Abc_Ntk_t *pNtk) {
+  pabc::Aig_Man_t *pAig = pabc::Abc_NtkToDarChoices(pNtk);
+  pabc::Gia_Man_t *gia = pabc::Gia_ManFromAigChoices(pAig);
+  pabc::Aig_ManStop(pAig);
+  return gia;
+}
+
+}  // namespace MagicLS
+
+#endif
@@ -0,0 +1,520 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file compressed_io.hpp
+ *
+ * @brief  Transparent gzip/zstd compressed input and output streams
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/16
+ */
+
+#ifndef COMPRESSED_IO_HPP
+#define COMPRESSED_IO_HPP
+
+#include <misc/zlib/zlib.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <lorina/common.hpp>
+
+#ifdef MAGICLS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace MagicLS {
+
+enum class compression { none, gzip, zstd };
+
+/* The compression format is selected by the file extension. */
+inline compression compression_of(std::string const &filename) {
+  auto ends_with = [&](std::string const &suffix) {
+    return filename.size() >= suffix.size() &&
+           filename.compare(filename.size() - suffix.size(), suffix.size(),
+                            suffix) == 0;
+  };
+  if (ends_with(".gz")) {
+    return compression::gzip;
+  }
+  if (ends_with(".zst") || ends_with(".zstd")) {
+    return compression::zstd;
+  }
+  return compression::none;
+}
+
+namespace detail {
+
+/* Produces decompressed bytes, `read` returns 0 only at the end. */
+class block_source {
+ public:
+  virtual ~block_source() = default;
+  virtual std::size_t read(char *data, std::size_t size) = 0;
+};
+
+/* Consumes uncompressed bytes, `finish` flushes and closes the file. */
+class block_sink {
+ public:
+  virtual ~block_sink() = default;
+  virtual void write(char const *data, std::size_t size) = 0;
+  virtual void finish() = 0;
+};
+
+/* gzip through the zlib bundled with ABC */
+class gzip_source : public block_source {
+ public:
+  explicit gzip_source(std::string const &filename) {
+    file_ = pabc::gzopen(filename.c_str(), "rb");
+    if (!file_) {
+      throw std::runtime_error("cannot open " + filename);
+    }
+  }
+
+  ~gzip_source() override { pabc::gzclose(file_); }
+
+  std::size_t read(char *data, std::size_t size) override {
+    std::size_t total = 0u;
+    while (total < size) {
+      const int n = pabc::gzread(file_, data + total,
+                                 static_cast<unsigned>(size - total));
+      if (n < 0) {
+        int err = 0;
+        throw std::runtime_error(std::string("gzip: ") +
+                                 pabc::gzerror(file_, &err));
+      }
+      if (n == 0) {
+        break;
+      }
+      total += static_cast<std::size_t>(n);
+    }
+    return total;
+  }
+
+ private:
+  pabc::gzFile file_;
+};
+
+class gzip_sink : public block_sink {
+ public:
+  explicit gzip_sink(std::string const &filename) {
+    file_ = pabc::gzopen(filename.c_str(), "wb6");
+    if (!file_) {
+      throw std::runtime_error("cannot open " + filename);
+    }
+  }
+
+  ~gzip_sink() override {
+    if (file_) {
+      pabc::gzclose(file_);
+    }
+  }
+
+  void write(char const *data, std::size_t size) override {
+    if (size != 0u &&
+        pabc::gzwrite(file_, const_cast<char *>(data),
+                      static_cast<unsigned>(size)) == 0) {
+      int err = 0;
+      throw std::runtime_error(std::string("gzip: ") +
+                               pabc::gzerror(file_, &err));
+    }
+  }
+
+  void finish() override {
+    const auto status = pabc::gzclose(file_);
+    file_ = nullptr;
+    if (status != Z_OK) {
+      throw std::runtime_error("gzip: cannot close the output file");
+    }
+  }
+
+ private:
+  pabc::gzFile file_;
+};
+
+#ifdef MAGICLS_ZSTD
+class zstd_source : public block_source {
+ public:
+  explicit zstd_source(std::string const &filename)
+      : in_(ZSTD_DStreamInSize()) {
+    file_ = std::fopen(filename.c_str(), "rb");
+    if (!file_) {
+      throw std::runtime_error("cannot open " + filename);
+    }
+    stream_ = ZSTD_createDStream();
+    ZSTD_initDStream(stream_);
+  }
+
+  ~zstd_source() override {
+    ZSTD_freeDStream(stream_);
+    std::fclose(file_);
+  }
+
+  std::size_t read(char *data, std::size_t size) override {
+    ZSTD_outBuffer out{data, size, 0u};
+    while (out.pos < out.size) {
+      if (input_.pos == input_.size && !eof_) {
+        const auto n = std::fread(in_.data(), 1u, in_.size(), file_);
+        if (n == 0u) {
+          eof_ = true;
+        } else {
+          input_ = ZSTD_inBuffer{in_.data(), n, 0u};
+        }
+      }
+      /* with the input exhausted the call only flushes buffered output */
+      const auto before = out.pos;
+      const auto r = ZSTD_decompressStream(stream_, &out, &input_);
+      if (ZSTD_isError(r)) {
+        throw std::runtime_error(std::string("zstd: ") + ZSTD_getErrorName(r));
+      }
+      if (eof_ && input_.pos == input_.size && out.pos == before) {
+        break;
+      }
+    }
+    return out.pos;
+  }
+
+ private:
+  std::FILE *file_;
+  ZSTD_DStream *stream_;
+  std::vector<char> in_;
+  ZSTD_inBuffer input_{nullptr, 0u, 0u};
+  bool eof_ = false;
+};
+
+class zstd_sink : public block_sink {
+ public:
+  explicit zstd_sink(std::string const &filename) : out_(ZSTD_CStreamOutSize()) {
+    file_ = std::fopen(filename.c_str(), "wb");
+    if (!file_) {
+      throw std::runtime_error("cannot open " + filename);
+    }
+    ctx_ = ZSTD_createCCtx();
+    ZSTD_CCtx_setParameter(ctx_, ZSTD_c_compressionLevel, 3);
+    /* only honoured when libzstd is built with multi-threading */
+    ZSTD_CCtx_setParameter(
+        ctx_, ZSTD_c_nbWorkers,
+        static_cast<int>(std::min(4u, std::thread::hardware_concurrency())));
+  }
+
+  ~zstd_sink() override {
+    ZSTD_freeCCtx(ctx_);
+    if (file_) {
+      std::fclose(file_);
+    }
+  }
+
+  void write(char const *data, std::size_t size) override {
+    ZSTD_inBuffer in{data, size, 0u};
+    while (in.pos < in.size) {
+      compress(in, ZSTD_e_continue);
+    }
+  }
+
+  void finish() override {
+    ZSTD_inBuffer in{nullptr, 0u, 0u};
+    while (compress(in, ZSTD_e_end) != 0u) {
+    }
+    const auto status = std::fclose(file_);
+    file_ = nullptr;
+    if (status != 0) {
+      throw std::runtime_error("zstd: cannot close the output file");
+    }
+  }
+
+ private:
+  std::size_t compress(ZSTD_inBuffer &in, ZSTD_EndDirective mode) {
+    ZSTD_outBuffer out{out_.data(), out_.size(), 0u};
+    const auto r = ZSTD_compressStream2(ctx_, &out, &in, mode);
+    if (ZSTD_isError(r)) {
+      throw std::runtime_error(std::string("zstd: ") + ZSTD_getErrorName(r));
+    }
+    if (std::fwrite(out_.data(), 1u, out.pos, file_) != out.pos) {
+      throw std::runtime_error("zstd: write error");
+    }
+    return r;
+  }
+
+ private:
+  std::FILE *file_;
+  ZSTD_CCtx *ctx_;
+  std::vector<char> out_;
+};
+#endif
+
+inline std::unique_ptr<block_source> make_source(std::string const &filename) {
+  switch (compression_of(filename)) {
+    case compression::gzip:
+      return std::make_unique<gzip_source>(filename);
+#ifdef MAGICLS_ZSTD
+    case compression::zstd:
+      return std::make_unique<zstd_source>(filename);
+#endif
+    default:
+      throw std::runtime_error("no decompressor for " + filename);
+  }
+}
+
+inline std::unique_ptr<block_sink> make_sink(std::string const &filename) {
+  switch (compression_of(filename)) {
+    case compression::gzip:
+      return std::make_unique<gzip_sink>(filename);
+#ifdef MAGICLS_ZSTD
+    case compression::zstd:
+      return std::make_unique<zstd_sink>(filename);
+#endif
+    default:
+      throw std::runtime_error("no compressor for " + filename);
+  }
+}
+
+/*! \brief Input buffer fed by a decompression thread.
+ *
+ * The worker reads and decompresses blocks into a bounded queue while the
+ * parser consumes the previous ones, so file I/O, decompression and parsing
+ * overlap.  Errors of the worker end the stream and are rethrown by
+ * `rethrow_error`.
+ */
+class pipelined_streambuf : public std::streambuf {
+ public:
+  explicit pipelined_streambuf(std::unique_ptr<block_source> source,
+                               std::size_t block_size = 1u << 20,
+                               std::size_t depth = 4u)
+      : source_(std::move(source)), block_size_(block_size), depth_(depth) {
+    worker_ = std::thread([this]() { produce(); });
+  }
+
+  ~pipelined_streambuf() override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    worker_.join();
+  }
+
+  void rethrow_error() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+  }
+
+ protected:
+  int_type underflow() override {
+    if (gptr() < egptr()) {
+      return traits_type::to_int_type(*gptr());
+    }
+    if (eof_) {
+      return traits_type::eof();
+    }
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [&]() { return !queue_.empty(); });
+      current_ = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    cv_.notify_all();
+
+    if (current_.empty()) {
+      eof_ = true;
+      return traits_type::eof();
+    }
+    setg(current_.data(), current_.data(), current_.data() + current_.size());
+    return traits_type::to_int_type(*gptr());
+  }
+
+ private:
+  void produce() {
+    try {
+      while (true) {
+        std::vector<char> block(block_size_);
+        block.resize(source_->read(block.data(), block.size()));
+        const bool last = block.empty();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&]() { return stop_ || queue_.size() < depth_; });
+        if (stop_) {
+          return;
+        }
+        queue_.push_back(std::move(block));
+        lock.unlock();
+        cv_.notify_all();
+        if (last) {
+          return;
+        }
+      }
+    } catch (...) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        error_ = std::current_exception();
+        queue_.emplace_back();
+      }
+      cv_.notify_all();
+    }
+  }
+
+ private:
+  std::unique_ptr<block_source> source_;
+  std::size_t block_size_;
+  std::size_t depth_;
+
+  std::thread worker_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::vector<char>> queue_;
+  std::exception_ptr error_;
+  bool stop_ = false;
+
+  /* consumer side */
+  std::vector<char> current_;
+  bool eof_ = false;
+};
+
+/* Output buffer handing 1 MiB blocks to a compressor. */
+class sink_streambuf : public std::streambuf {
+ public:
+  explicit sink_streambuf(std::unique_ptr<block_sink> sink,
+                          std::size_t block_size = 1u << 20)
+      : sink_(std::move(sink)), buffer_(block_size) {
+    setp(buffer_.data(), buffer_.data() + buffer_.size());
+  }
+
+  /* flushes the remaining data, throws on any earlier write error */
+  void finish() {
+    flush_buffer();
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+    sink_->finish();
+  }
+
+ protected:
+  int_type overflow(int_type c) override {
+    if (!flush_buffer()) {
+      return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+  int sync() override { return flush_buffer() ? 0 : -1; }
+
+ private:
+  bool flush_buffer() {
+    if (error_) {
+      return false;
+    }
+    try {
+      if (pptr() != pbase()) {
+        sink_->write(pbase(), static_cast<std::size_t>(pptr() - pbase()));
+      }
+    } catch (...) {
+      error_ = std::current_exception();
+      return false;
+    }
+    setp(buffer_.data(), buffer_.data() + buffer_.size());
+    return true;
+  }
+
+ private:
+  std::unique_ptr<block_sink> sink_;
+  std::vector<char> buffer_;
+  std::exception_ptr error_;
+};
+
+/* Calls `fn(std::istream&)` on the (decompressed) contents of `filename`. */
+template <typename Fn>
+auto with_input(std::string const &filename, Fn &&fn) {
+  if (compression_of(filename) == compression::none) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) {
+      throw std::runtime_error("cannot open " + filename);
+    }
+    return fn(static_cast<std::istream &>(in));
+  }
+
+  pipelined_streambuf buf(make_source(filename));
+  std::istream in(&buf);
+  auto result = fn(in);
+  buf.rethrow_error();
+  return result;
+}
+
+/* Calls `fn(std::ostream&)` and compresses its output into `filename`. */
+template <typename Fn>
+void with_output(std::string const &filename, Fn &&fn) {
+  if (compression_of(filename) == compression::none) {
+    std::ofstream os(filename, std::ios::binary | std::ios::trunc);
+    if (!os) {
+      throw std::runtime_error("cannot open " + filename);
+    }
+    fn(static_cast<std::ostream &>(os));
+    os.flush();
+    if (!os) {
+      throw std::runtime_error("cannot write " + filename);
+    }
+    return;
+  }
+
+  sink_streambuf buf(make_sink(filename));
+  std::ostream os(&buf);
+  fn(os);
+  buf.finish();
+}
+
+}  // namespace detail
+
+/*! \brief Runs a lorina parser on a plain or compressed file.
+ *
+ * `fn` receives the input stream and returns the lorina return code; I/O and
+ * decompression errors are reported and turned into a parse error.
+ */
+template <typename Fn>
+lorina::return_code parse_file(std::string const &filename, Fn &&fn) {
+  try {
+    return detail::with_input(filename, std::forward<Fn>(fn));
+  } catch (std::exception const &e) {
+    std::cout << "[w] " << e.what() << "\n";
+    return lorina::return_code::parse_error;
+  }
+}
+
+/* Runs a writer on an output stream, compressing if the extension asks for it. */
+template <typename Fn>
+void write_file(std::string const &filename, Fn &&fn) {
+  try {
+    detail::with_output(filename, std::forward<Fn>(fn));
+  } catch (std::exception const &e) {
+    std::cout << "[e] " << e.what() << "\n";
+  }
+}
+
+/* Whole (decompressed) contents of a file, for readers that need a buffer. */
+inline std::string read_file_contents(std::string const &filename) {
+  return detail::with_input(filename, [](std::istream &in) {
+    return std::string(std::istreambuf_iterator<char>(in),
+                       std::istreambuf_iterator<char>());
+  });
+}
+
+}  // namespace MagicLS
+
+#endif
@@ -0,0 +1,221 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file convert.hpp
+ *
+ * @brief  Conversion between the AIG, MIG, XAG and XMG stores
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/02
+ */
+
+#ifndef CONVERT_HPP
+#define CONVERT_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <mockturtle/algorithms/collapse_mapped.hpp>
+#include <mockturtle/algorithms/lut_mapping.hpp>
+#include <mockturtle/algorithms/node_resynthesis.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/traits.hpp>
+#include <mockturtle/utils/node_map.hpp>
+#include <mockturtle/views/mapping_view.hpp>
+
+namespace MagicLS {
+
+/* Parameters shared by all ALICE_CONVERTs between mockturtle stores.
+ *
+ * `fast` converts gate for gate in one linear pass (AND -> MAJ(a, b, 0),
+ * XOR -> XOR3(a, b, 0), MAJ -> AND/OR, ...), otherwise the network is LUT
+ * mapped with `cut_size`-input cuts, collapsed and every LUT is resynthesized.
+ *
+ * The defaults can be set by the environment:
+ *   MAGICLS_CONVERT=fast|resyn   MAGICLS_CONVERT_CUT_SIZE=<k>
+ */
+struct convert_params {
+  bool fast = false;
+  uint32_t cut_size = 4u;
+};
+
+inline convert_params &convert_ps() {
+  static convert_params ps = []() {
+    convert_params p;
+    if (const char *mode = std::getenv("MAGICLS_CONVERT")) {
+      p.fast = std::string(mode) == "fast";
+    }
+    if (const char *k = std::getenv("MAGICLS_CONVERT_CUT_SIZE")) {
+      p.cut_size = std::max(2, std::atoi(k));
+    }
+    return p;
+  }();
+  return ps;
+}
+
+/* cut size actually used with the 4-input NPN databases */
+inline uint32_t npn_cut_size() { return std::min(convert_ps().cut_size, 4u); }
+
+namespace detail {
+
+template <class NtkDest>
+typename NtkDest::signal convert_and(NtkDest &dest,
+                                     typename NtkDest::signal const &a,
+                                     typename NtkDest::signal const &b) {
+  if constexpr (mockturtle::has_create_and_v<NtkDest>) {
+    return dest.create_and(a, b);
+  } else {
+    return dest.create_maj(a, b, dest.get_constant(false));
+  }
+}
+
+template <class NtkDest>
+typename NtkDest::signal convert_xor(NtkDest &dest,
+                                     typename NtkDest::signal const &a,
+                                     typename NtkDest::signal const &b) {
+  if constexpr (mockturtle::has_create_xor3_v<NtkDest>) {
+    return dest.create_xor3(a, b, dest.get_constant(false));
+  } else {
+    return dest.create_xor(a, b);
+  }
+}
+
+template <class NtkDest>
+typename NtkDest::signal convert_maj(NtkDest &dest,
+                                     typename NtkDest::signal const &a,
+                                     typename NtkDest::signal const &b,
+                                     typename NtkDest::signal const &c) {
+  if constexpr (mockturtle::has_create_maj_v<NtkDest>) {
+    return dest.create_maj(a, b, c);
+  } else {
+    /* MAJ(a, b, c) = ab + c(a + b) */
+    return dest.create_or(dest.create_and(a, b),
+                          dest.create_and(c, dest.create_or(a, b)));
+  }
+}
+
+}  // namespace detail
+
+/*! \brief Converts a network gate for gate.
+ *
+ * Every gate of `src` is rebuilt with the closest gate type of `NtkDest`
+ * in topological order, so the cost is a linear copy.  A MAJ with a
+ * constant fanin becomes an AND/OR, an XOR3 with a constant fanin an XOR,
+ * which keeps AIG/XAG structure intact through a round trip.
+ */
+template <class NtkDest, class NtkSrc>
+NtkDest direct_convert(NtkSrc const &src) {
+  using namespace mockturtle;
+  using src_signal = typename NtkSrc::signal;
+  using dest_signal = typename NtkDest::signal;
+
+  NtkDest dest;
+  node_map<dest_signal, NtkSrc> old2new(src);
+
+  old2new[src.get_constant(false)] = dest.get_constant(false);
+  if (src.get_node(src.get_constant(true)) !=
+      src.get_node(src.get_constant(false))) {
+    old2new[src.get_constant(true)] = dest.get_constant(true);
+  }
+  src.foreach_pi([&](auto const &n) { old2new[n] = dest.create_pi(); });
+
+  auto map_signal = [&](src_signal const &f) {
+    const auto s = old2new[src.get_node(f)];
+    return src.is_complemented(f) ? dest.create_not(s) : s;
+  };
+
+  src.foreach_gate([&](auto const &n) {
+    std::vector<dest_signal> fs;
+    src.foreach_fanin(n, [&](auto const &f) { fs.push_back(map_signal(f)); });
+
+    /* constant fanins of 3-input gates degenerate to 2-input gates */
+    auto split_constant = [&]() -> std::optional<bool> {
+      for (auto i = 0u; i < fs.size(); ++i) {
+        if (dest.is_constant(dest.get_node(fs[i]))) {
+          const bool value =
+              dest.constant_value(dest.get_node(fs[i])) != dest.is_complemented(fs[i]);
+          fs.erase(fs.begin() + i);
+          return value;
+        }
+      }
+      return std::nullopt;
+    };
+
+    if constexpr (has_is_xor3_v<NtkSrc>) {
+      if (src.is_xor3(n)) {
+        if (auto value = split_constant()) {
+          const auto x = detail::convert_xor(dest, fs[0], fs[1]);
+          old2new[n] = *value ? dest.create_not(x) : x;
+        } else if constexpr (has_create_xor3_v<NtkDest>) {
+          old2new[n] = dest.create_xor3(fs[0], fs[1], fs[2]);
+        } else {
+          old2new[n] = dest.create_xor(dest.create_xor(fs[0], fs[1]), fs[2]);
+        }
+        return;
+      }
+    }
+    if constexpr (has_is_maj_v<NtkSrc>) {
+      if (src.is_maj(n)) {
+        if (auto value = split_constant()) {
+          old2new[n] = *value ? dest.create_or(fs[0], fs[1])
+                              : detail::convert_and(dest, fs[0], fs[1]);
+        } else {
+          old2new[n] = detail::convert_maj(dest, fs[0], fs[1], fs[2]);
+        }
+        return;
+      }
+    }
+    if constexpr (has_is_xor_v<NtkSrc>) {
+      if (src.is_xor(n)) {
+        old2new[n] = detail::convert_xor(dest, fs[0], fs[1]);
+        return;
+      }
+    }
+    if constexpr (has_is_and_v<NtkSrc>) {
+      if (src.is_and(n)) {
+        old2new[n] = detail::convert_and(dest, fs[0], fs[1]);
+        return;
+      }
+    }
+    assert(false && "unsupported gate type");
+  });
+
+  src.foreach_po([&](auto const &f) { dest.create_po(map_signal(f)); });
+
+  return dest;
+}
+
+/*! \brief Converts a network by LUT mapping and node resynthesis.
+ *
+ * The network is mapped into `cut_size`-input LUTs, collapsed into a
+ * k-LUT network and every LUT is resynthesized by `resyn`.
+ */
+template <class NtkDest, class NtkSrc, class ResynFn>
+NtkDest lut_resynthesis_convert(NtkSrc const &src, ResynFn &&resyn,
+                                uint32_t cut_size) {
+  using namespace mockturtle;
+
+  NtkSrc ntk = src;
+
+  /* LUT mapping */
+  mapping_view<NtkSrc, true> mapped{ntk};
+  lut_mapping_params ps;
+  ps.cut_enumeration_ps.cut_size = cut_size;
+  lut_mapping<mapping_view<NtkSrc, true>, true>(mapped, ps);
+
+  /* collapse into k-LUT network */
+  const auto klut = *collapse_mapped_network<klut_network>(mapped);
+
+  /* node resynthesis */
+  return node_resynthesis<NtkDest>(klut, resyn);
+}
+
+}  // namespace MagicLS
+
+#endif
@@ -0,0 +1,370 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file exact_cache.hpp
+ *
+ * @brief  Process-wide NPN-keyed cache of exact AIG synthesis results
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/04
+ */
+
+#ifndef EXACT_CACHE_HPP
+#define EXACT_CACHE_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/hash.hpp>
+#include <kitty/npn.hpp>
+#include <kitty/operators.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/networks/aig.hpp>
+
+namespace MagicLS {
+
+/* An AIG over the inputs of an NPN representative.
+ *
+ * Literals are `2 * index + complement`, index 0 is the constant, indexes
+ * 1..num_vars are the inputs and the i-th gate has index num_vars + 1 + i.
+ */
+struct aig_chain {
+  uint32_t num_vars = 0u;
+  std::vector<std::pair<uint32_t, uint32_t>> gates;
+  uint32_t output = 0u;
+};
+
+/* Whether every literal of `chain` refers to the constant, an input or an
+ * earlier gate. */
+inline bool is_well_formed(aig_chain const &chain) {
+  auto bound = 2u * (1u + chain.num_vars);
+  for (auto const &[a, b] : chain.gates) {
+    if (a >= bound || b >= bound) {
+      return false;
+    }
+    bound += 2u;
+  }
+  return chain.output < bound;
+}
+
+/* Function of a well-formed chain over its inputs */
+inline kitty::dynamic_truth_table simulate_chain(aig_chain const &chain) {
+  std::vector<kitty::dynamic_truth_table> tts(1u + chain.num_vars + chain.gates.size(),
+                                              kitty::dynamic_truth_table(chain.num_vars));
+  for (auto i = 0u; i < chain.num_vars; ++i) {
+    kitty::create_nth_var(tts[i + 1u], i);
+  }
+  auto tt_of = [&](uint32_t lit) { return (lit & 1u) ? ~tts[lit >> 1u] : tts[lit >> 1u]; };
+  for (auto g = 0u; g < chain.gates.size(); ++g) {
+    tts[1u + chain.num_vars + g] = tt_of(chain.gates[g].first) & tt_of(chain.gates[g].second);
+  }
+  auto tt = tt_of(chain.output);
+  tt.mask_bits();
+  return tt;
+}
+
+/*! \brief Process-wide cache of exact synthesis results keyed by NPN class.
+ *
+ * All member functions are thread-safe.  If the environment variable
+ * MAGICLS_EXACT_CACHE names a file, it is loaded on first use and written
+ * back at exit when new entries were added.
+ *
+ * File format (little endian): "MLSE", u32 version, u32 #entries, then per
+ * entry u32 num_vars, the truth table words (u64), u32 #gates, the fanin
+ * literal pairs (u32) and the output literal (u32).
+ */
+class exact_cache {
+ public:
+  using key_t = kitty::dynamic_truth_table;
+
+  static exact_cache &instance() {
+    static exact_cache cache;
+    return cache;
+  }
+
+  std::optional<aig_chain> lookup(key_t const &key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = map_.find(key);
+    if (it == map_.end()) {
+      ++misses_;
+      return std::nullopt;
+    }
+    ++hits_;
+    return it->second;
+  }
+
+  void insert(key_t const &key, aig_chain const &chain) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (map_.emplace(key, chain).second) {
+      dirty_ = true;
+    }
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    map_.clear();
+    hits_ = misses_ = 0u;
+    dirty_ = false;
+  }
+
+  std::size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return map_.size();
+  }
+
+  uint64_t hits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+  }
+
+  uint64_t misses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+  }
+
+  /* merges the entries of `filename` into the cache, returns false on error;
+   * counts are bounded by the file size and every chain must compute its
+   * key, so a corrupt file can neither exhaust memory nor poison the cache */
+  bool load(std::string const &filename) {
+    std::ifstream in(filename, std::ios::binary | std::ios::ate);
+    if (!in) {
+      return false;
+    }
+    const auto size = static_cast<uint64_t>(in.tellg());
+    in.seekg(0);
+    auto remaining = [&]() { return size - static_cast<uint64_t>(in.tellg()); };
+
+    /* num_vars, one word, num_gates and output */
+    constexpr uint64_t min_entry_size = 4u + 8u + 4u + 4u;
+    char magic[4];
+    uint32_t version = 0u, count = 0u;
+    in.read(magic, 4);
+    if (!in || std::string(magic, 4) != "MLSE" || !read(in, version) ||
+        version != file_version || !read(in, count) ||
+        count > remaining() / min_entry_size) {
+      return false;
+    }
+
+    std::vector<std::pair<key_t, aig_chain>> entries;
+    entries.reserve(count);
+    for (auto e = 0u; e < count; ++e) {
+      aig_chain chain;
+      uint32_t num_gates = 0u;
+      if (!read(in, chain.num_vars) || chain.num_vars > 16u) {
+        return false;
+      }
+      key_t key(chain.num_vars);
+      std::vector<uint64_t> words(key.num_blocks());
+      for (auto &w : words) {
+        if (!read(in, w)) {
+          return false;
+        }
+      }
+      kitty::create_from_words(key, words.begin(), words.end());
+      if (!read(in, num_gates) || num_gates > remaining() / 8u) {
+        return false;
+      }
+      chain.gates.resize(num_gates);
+      for (auto &g : chain.gates) {
+        if (!read(in, g.first) || !read(in, g.second)) {
+          return false;
+        }
+      }
+      if (!read(in, chain.output) || !is_well_formed(chain)) {
+        return false;
+      }
+      key.mask_bits();
+      if (simulate_chain(chain) != key) {
+        return false;
+      }
+      entries.emplace_back(std::move(key), std::move(chain));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &[key, chain] : entries) {
+      map_.emplace(std::move(key), std::move(chain));
+    }
+    return true;
+  }
+
+  bool save(std::string const &filename) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      return false;
+    }
+
+    out.write("MLSE", 4);
+    write(out, file_version);
+    write(out, static_cast<uint32_t>(map_.size()));
+    for (auto const &[key, chain] : map_) {
+      write(out, chain.num_vars);
+      for (auto it = key.begin(); it != key.end(); ++it) {
+        write(out, static_cast<uint64_t>(*it));
+      }
+      write(out, static_cast<uint32_t>(chain.gates.size()));
+      for (auto const &g : chain.gates) {
+        write(out, g.first);
+        write(out, g.second);
+      }
+      write(out, chain.output);
+    }
+    dirty_ = false;
+    return static_cast<bool>(out);
+  }
+
+  ~exact_cache() {
+    if (dirty_ && !env_file_.empty()) {
+      save(env_file_);
+    }
+  }
+
+ private:
+  exact_cache() {
+    if (const char *file = std::getenv("MAGICLS_EXACT_CACHE")) {
+      env_file_ = file;
+      load(env_file_);
+    }
+  }
+
+  template <typename T>
+  static bool read(std::istream &in, T &value) {
+    in.read(reinterpret_cast<char *>(&value), sizeof(T));
+    return static_cast<bool>(in);
+  }
+
+  template <typename T>
+  static void write(std::ostream &out, T const &value) {
+    out.write(reinterpret_cast<char const *>(&value), sizeof(T));
+  }
+
+ private:
+  static constexpr uint32_t file_version = 1u;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<key_t, aig_chain, kitty::hash<key_t>> map_;
+  uint64_t hits_ = 0u;
+  uint64_t misses_ = 0u;
+  bool dirty_ = false;
+  std::string env_file_;
+};
+
+/*! \brief Resynthesis function caching `ResynFn` results per NPN class.
+ *
+ * The function is NPN canonized, the representative is looked up in the
+ * process-wide `exact_cache` and, on a miss, synthesized once by `resyn`.
+ * The cached chain is then instantiated with permuted and complemented
+ * leaves, similar to `xag_npn_resynthesis`.  Functions with more than
+ * `max_vars` inputs are passed to `resyn` directly.
+ */
+template <class Ntk, class ResynFn>
+class npn_cached_resynthesis {
+ public:
+  using signal = typename Ntk::signal;
+
+  explicit npn_cached_resynthesis(ResynFn &resyn, uint32_t max_vars = 6u)
+      : resyn_(resyn), max_vars_(max_vars) {}
+
+  template <typename LeavesIterator, typename Fn>
+  void operator()(Ntk &ntk, kitty::dynamic_truth_table const &function,
+                  LeavesIterator begin, LeavesIterator end, Fn &&fn) {
+    const auto num_vars = function.num_vars();
+    if (num_vars == 0u || num_vars > max_vars_) {
+      resyn_(ntk, function, begin, end, fn);
+      return;
+    }
+
+    const auto [canon, phase, perm] = kitty::exact_npn_canonization(function);
+
+    auto chain = exact_cache::instance().lookup(canon);
+    if (!chain) {
+      chain = synthesize(canon);
+      if (!chain) {
+        return;
+      }
+      exact_cache::instance().insert(canon, *chain);
+    }
+
+    std::vector<signal> leaves(begin, end);
+    leaves.resize(std::max<std::size_t>(leaves.size(), num_vars),
+                  ntk.get_constant(false));
+
+    std::vector<signal> sigs;
+    sigs.reserve(1u + num_vars + chain->gates.size());
+    sigs.push_back(ntk.get_constant(false));
+    for (auto i = 0u; i < num_vars; ++i) {
+      const auto leaf = leaves[perm[i]];
+      sigs.push_back(((phase >> perm[i]) & 1) ? ntk.create_not(leaf) : leaf);
+    }
+
+    auto lit_to_signal = [&](uint32_t lit) {
+      return (lit & 1) ? ntk.create_not(sigs[lit >> 1]) : sigs[lit >> 1];
+    };
+    for (auto const &[a, b] : chain->gates) {
+      sigs.push_back(ntk.create_and(lit_to_signal(a), lit_to_signal(b)));
+    }
+
+    auto f = lit_to_signal(chain->output);
+    if ((phase >> num_vars) & 1) {
+      f = ntk.create_not(f);
+    }
+    fn(f);
+  }
+
+ private:
+  std::optional<aig_chain> synthesize(kitty::dynamic_truth_table const &tt) {
+    mockturtle::aig_network aig;
+    std::vector<mockturtle::aig_network::signal> pis(tt.num_vars());
+    for (auto &pi : pis) {
+      pi = aig.create_pi();
+    }
+
+    bool found = false;
+    resyn_(aig, tt, pis.begin(), pis.end(), [&](auto const &f) {
+      aig.create_po(f);
+      found = true;
+      return false;
+    });
+    if (!found) {
+      return std::nullopt;
+    }
+
+    /* after cleanup the node indexes are const, inputs, gates in order */
+    aig = mockturtle::cleanup_dangling(aig);
+
+    auto to_lit = [&](mockturtle::aig_network::signal const &s) {
+      return static_cast<uint32_t>(aig.node_to_index(aig.get_node(s)) * 2u +
+                                   (aig.is_complemented(s) ? 1u : 0u));
+    };
+
+    aig_chain chain;
+    chain.num_vars = tt.num_vars();
+    aig.foreach_gate([&](auto const &n) {
+      std::pair<uint32_t, uint32_t> gate;
+      aig.foreach_fanin(n, [&](auto const &f, auto i) {
+        (i == 0 ? gate.first : gate.second) = to_lit(f);
+      });
+      chain.gates.push_back(gate);
+    });
+    aig.foreach_po([&](auto const &f) { chain.output = to_lit(f); });
+    return chain;
+  }
+
+ private:
+  ResynFn &resyn_;
+  uint32_t max_vars_;
+};
+
+}  // namespace MagicLS
+
+#endif
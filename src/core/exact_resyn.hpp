@@ -0,0 +1,284 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file exact_resyn.hpp
+ *
+ * @brief  Exact resynthesis of small windows of AIGs and XAGs
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/28
+ */
+
+#ifndef EXACT_RESYN_HPP
+#define EXACT_RESYN_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <future>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/utils/node_map.hpp>
+
+#include "./exact_synthesis.hpp"
+#include "./thread_pool.hpp"
+
+namespace MagicLS {
+
+struct exact_resyn_params {
+  /* maximum number of inputs of a window */
+  uint32_t cut_size = 6u;
+  /* cuts kept per node while enumerating windows */
+  uint32_t cut_limit = 8u;
+  /* per window; max_gates is further bounded by the MFFC size */
+  exact_synthesis_params synthesis{7u, 10000u};
+};
+
+struct exact_resyn_stats {
+  uint32_t windows = 0u;
+  uint32_t replaced = 0u;
+  /* windows whose synthesis hit a limit or found nothing smaller */
+  uint32_t kept = 0u;
+  /* gates saved by the replacements before strashing */
+  uint32_t gain = 0u;
+};
+
+namespace detail {
+
+template <class Ntk>
+struct exact_window {
+  typename Ntk::node root;
+  std::vector<typename Ntk::node> leaves;
+  /* the gates freed when the root is replaced */
+  std::vector<typename Ntk::node> mffc;
+};
+
+/* Maximum fanout-free cone of `root` bounded by `leaves`, root first.  The
+ * reference counts are kept locally, so windows can be analysed in
+ * parallel. */
+template <class Ntk>
+std::vector<typename Ntk::node> window_mffc(Ntk const &ntk, typename Ntk::node const &root,
+                                            std::vector<typename Ntk::node> const &leaves) {
+  using node = typename Ntk::node;
+  std::unordered_map<node, uint32_t> refs;
+  std::vector<node> mffc{root}, stack{root};
+  while (!stack.empty()) {
+    const auto n = stack.back();
+    stack.pop_back();
+    ntk.foreach_fanin(n, [&](auto const &f) {
+      const auto c = ntk.get_node(f);
+      if (ntk.is_constant(c) || ntk.is_pi(c) ||
+          std::find(leaves.begin(), leaves.end(), c) != leaves.end()) {
+        return;
+      }
+      auto it = refs.try_emplace(c, ntk.fanout_size(c)).first;
+      if (--it->second == 0u) {
+        mffc.push_back(c);
+        stack.push_back(c);
+      }
+    });
+  }
+  return mffc;
+}
+
+/* Function of the root over the leaves, simulating the cone word-parallel. */
+template <class Ntk>
+kitty::dynamic_truth_table window_function(Ntk const &ntk, exact_window<Ntk> const &win) {
+  using node = typename Ntk::node;
+  const auto num_vars = static_cast<uint32_t>(win.leaves.size());
+
+  std::unordered_map<node, kitty::dynamic_truth_table> tts;
+  for (auto i = 0u; i < num_vars; ++i) {
+    kitty::dynamic_truth_table var(num_vars);
+    kitty::create_nth_var(var, i);
+    tts.emplace(win.leaves[i], var);
+  }
+
+  std::vector<node> cone, stack{win.root};
+  std::unordered_set<node> visited{win.root};
+  while (!stack.empty()) {
+    const auto n = stack.back();
+    stack.pop_back();
+    cone.push_back(n);
+    ntk.foreach_fanin(n, [&](auto const &f) {
+      const auto c = ntk.get_node(f);
+      if (!ntk.is_constant(c) && tts.count(c) == 0u && visited.insert(c).second) {
+        stack.push_back(c);
+      }
+    });
+  }
+
+  /* node indexes are topological */
+  std::sort(cone.begin(), cone.end(),
+            [&](auto a, auto b) { return ntk.node_to_index(a) < ntk.node_to_index(b); });
+  for (auto const &n : cone) {
+    std::vector<kitty::dynamic_truth_table> fanin_tts;
+    ntk.foreach_fanin(n, [&](auto const &f) {
+      const auto c = ntk.get_node(f);
+      fanin_tts.push_back(ntk.is_constant(c) ? kitty::dynamic_truth_table(num_vars) : tts.at(c));
+    });
+    tts[n] = ntk.compute(n, fanin_tts.begin(), fanin_tts.end());
+  }
+  return tts.at(win.root);
+}
+
+}  // namespace detail
+
+/*! \brief Replaces small windows by size-optimal chains.
+ *
+ * Every gate proposes the cut of at most `cut_size` leaves with the largest
+ * maximum fanout-free cone.  Proposals are accepted greedily by cone size
+ * as long as no accepted cone contains a gate or a leaf of another window,
+ * so the accepted windows can be replaced independently.  Their functions
+ * are simulated and synthesized on the pool through the NPN cache, looking
+ * only for chains smaller than the cone; a window is replaced if such a
+ * chain is found.
+ */
+template <class Ntk>
+Ntk exact_resynthesize(Ntk const &ntk, exact_resyn_params const &ps, thread_pool &pool,
+                       exact_resyn_stats *pst = nullptr) {
+  static_assert(std::is_same_v<Ntk, mockturtle::aig_network> ||
+                    std::is_same_v<Ntk, mockturtle::xag_network>,
+                "exact resynthesis supports AIGs and XAGs");
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+  using window = detail::exact_window<Ntk>;
+  constexpr auto basis =
+      std::is_same_v<Ntk, mockturtle::xag_network> ? exact_basis::xag : exact_basis::aig;
+
+  mockturtle::cut_enumeration_params cps;
+  cps.cut_size = ps.cut_size;
+  cps.cut_limit = ps.cut_limit;
+  auto cuts = mockturtle::cut_enumeration(ntk, cps);
+
+  /* proposals, in chunks of gates analysed in parallel */
+  std::vector<node> gates;
+  gates.reserve(ntk.num_gates());
+  ntk.foreach_gate([&](auto const &n) { gates.push_back(n); });
+  const auto chunk = std::max<std::size_t>(64u, gates.size() / (4u * pool.size()) + 1u);
+  std::vector<std::future<std::vector<window>>> proposed;
+  for (std::size_t first = 0u; first < gates.size(); first += chunk) {
+    proposed.push_back(pool.submit([&, first]() {
+      std::vector<window> ws;
+      const auto last = std::min(first + chunk, gates.size());
+      for (auto i = first; i < last; ++i) {
+        std::optional<window> best;
+        for (auto const &cut : cuts.cuts(ntk.node_to_index(gates[i]))) {
+          if (cut->size() < 2u) {
+            continue;
+          }
+          std::vector<node> leaves;
+          for (auto l : *cut) {
+            leaves.push_back(ntk.index_to_node(l));
+          }
+          auto mffc = detail::window_mffc(ntk, gates[i], leaves);
+          if (mffc.size() >= 2u && (!best || mffc.size() > best->mffc.size())) {
+            best = window{gates[i], std::move(leaves), std::move(mffc)};
+          }
+        }
+        if (best) {
+          ws.push_back(std::move(*best));
+        }
+      }
+      return ws;
+    }));
+  }
+  std::vector<window> candidates;
+  for (auto &f : proposed) {
+    for (auto &w : f.get()) {
+      candidates.push_back(std::move(w));
+    }
+  }
+
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](auto const &a, auto const &b) { return a.mffc.size() > b.mffc.size(); });
+  constexpr uint8_t in_cone = 1u, is_leaf = 2u;
+  std::vector<uint8_t> mark(ntk.size(), 0u);
+  std::vector<window> windows;
+  for (auto &w : candidates) {
+    const auto free = std::all_of(w.mffc.begin(), w.mffc.end(),
+                                  [&](auto n) { return mark[ntk.node_to_index(n)] == 0u; }) &&
+                      std::none_of(w.leaves.begin(), w.leaves.end(),
+                                   [&](auto n) { return mark[ntk.node_to_index(n)] & in_cone; });
+    if (!free) {
+      continue;
+    }
+    for (auto const &n : w.mffc) {
+      mark[ntk.node_to_index(n)] |= in_cone;
+    }
+    for (auto const &n : w.leaves) {
+      mark[ntk.node_to_index(n)] |= is_leaf;
+    }
+    windows.push_back(std::move(w));
+  }
+
+  std::vector<std::future<std::optional<exact_chain>>> chains;
+  chains.reserve(windows.size());
+  for (auto const &w : windows) {
+    chains.push_back(pool.submit([&ntk, &w, &ps]() -> std::optional<exact_chain> {
+      auto sps = ps.synthesis;
+      sps.max_gates = std::min<uint32_t>(sps.max_gates, w.mffc.size() - 1u);
+      auto chain = exact_synthesize_cached(detail::window_function(ntk, w), basis, sps);
+      if (chain && chain->gates.size() < w.mffc.size()) {
+        return chain;
+      }
+      return std::nullopt;
+    }));
+  }
+
+  exact_resyn_stats st;
+  st.windows = static_cast<uint32_t>(windows.size());
+  std::unordered_map<node, std::pair<window const *, exact_chain>> replacements;
+  for (auto i = 0u; i < windows.size(); ++i) {
+    if (auto chain = chains[i].get()) {
+      ++st.replaced;
+      st.gain += static_cast<uint32_t>(windows[i].mffc.size() - chain->gates.size());
+      replacements.emplace(windows[i].root, std::make_pair(&windows[i], std::move(*chain)));
+    } else {
+      ++st.kept;
+    }
+  }
+
+  Ntk res;
+  mockturtle::node_map<signal, Ntk> old2new(ntk);
+  old2new[ntk.get_constant(false)] = res.get_constant(false);
+  ntk.foreach_pi([&](auto const &n) { old2new[n] = res.create_pi(); });
+  ntk.foreach_gate([&](auto const &n) {
+    if (auto it = replacements.find(n); it != replacements.end()) {
+      std::vector<signal> leaves;
+      for (auto const &l : it->second.first->leaves) {
+        leaves.push_back(old2new[l]);
+      }
+      old2new[n] = instantiate_chain(res, it->second.second, leaves);
+      return;
+    }
+    std::vector<signal> children;
+    ntk.foreach_fanin(n, [&](auto const &f) {
+      children.push_back(ntk.is_complemented(f) ? res.create_not(old2new[f]) : old2new[f]);
+    });
+    old2new[n] = res.clone_node(ntk, n, children);
+  });
+  ntk.foreach_po([&](auto const &f) {
+    res.create_po(ntk.is_complemented(f) ? res.create_not(old2new[f]) : old2new[f]);
+  });
+
+  if (pst) {
+    *pst = st;
+  }
+  /* the replaced cones are dangling now */
+  return mockturtle::cleanup_dangling(res);
+}
+
+}  // namespace MagicLS
+
+#endif
@@ -0,0 +1,568 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file exact_synthesis.hpp
+ *
+ * @brief  SAT-based size-optimal synthesis of AIGs, XAGs, MIGs and XMGs
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/27
+ */
+
+#ifndef EXACT_SYNTHESIS_HPP
+#define EXACT_SYNTHESIS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <future>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <bill/sat/interface/common.hpp>
+#include <bill/sat/interface/ghack.hpp>
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/hash.hpp>
+#include <kitty/npn.hpp>
+#include <kitty/operations.hpp>
+#include <kitty/operators.hpp>
+#include <mockturtle/traits.hpp>
+
+#include "./npn.hpp"
+
+namespace MagicLS {
+
+enum class exact_basis { aig, xag, mig, xmg };
+
+enum class exact_gate_kind : uint8_t { and2, xor2, maj3, xor3 };
+
+/* Literals are `2 * index + complement`, index 0 is the constant, indexes
+ * 1..num_vars are the inputs and the i-th gate has index num_vars + 1 + i.
+ * Two-input gates leave the third fanin unused. */
+struct exact_gate {
+  exact_gate_kind kind = exact_gate_kind::and2;
+  std::array<uint32_t, 3> fanins{};
+};
+
+struct exact_chain {
+  uint32_t num_vars = 0u;
+  std::vector<exact_gate> gates;
+  uint32_t output = 0u;
+};
+
+struct exact_synthesis_params {
+  /* give up on functions needing more gates */
+  uint32_t max_gates = 12u;
+  /* conflicts per SAT call, 0 for none; a hit limit gives up too */
+  uint32_t conflict_limit = 0u;
+};
+
+namespace detail {
+
+/* A normal gate function, i.e. one that is 0 if all fanins are 0. */
+struct exact_op {
+  exact_gate_kind kind;
+  uint32_t input_mask;
+  bool output_complement;
+};
+
+inline uint32_t exact_arity(exact_basis basis) {
+  return basis == exact_basis::aig || basis == exact_basis::xag ? 2u : 3u;
+}
+
+/* The gates of the basis with complemented fanins, up to normalization.
+ * Complemented outputs are moved into the fanin literals of the users. */
+inline std::vector<exact_op> exact_ops(exact_basis basis) {
+  using k = exact_gate_kind;
+  switch (basis) {
+    case exact_basis::aig:
+      return {{k::and2, 0u, false}, {k::and2, 1u, false}, {k::and2, 2u, false},
+              {k::and2, 3u, true}};
+    case exact_basis::xag:
+      return {{k::and2, 0u, false}, {k::and2, 1u, false}, {k::and2, 2u, false},
+              {k::and2, 3u, true}, {k::xor2, 0u, false}};
+    case exact_basis::mig:
+      return {{k::maj3, 0u, false}, {k::maj3, 1u, false}, {k::maj3, 2u, false},
+              {k::maj3, 4u, false}};
+    default:
+      return {{k::maj3, 0u, false}, {k::maj3, 1u, false}, {k::maj3, 2u, false},
+              {k::maj3, 4u, false}, {k::xor3, 0u, false}};
+  }
+}
+
+inline bool exact_eval(exact_gate_kind kind, uint32_t bits) {
+  const bool a = bits & 1u, b = (bits >> 1u) & 1u, c = (bits >> 2u) & 1u;
+  switch (kind) {
+    case exact_gate_kind::and2:
+      return a && b;
+    case exact_gate_kind::xor2:
+      return a != b;
+    case exact_gate_kind::maj3:
+      return (a && b) || (a && c) || (b && c);
+    default:
+      return (a != b) != c;
+  }
+}
+
+inline bool exact_eval(exact_op const &op, uint32_t bits) {
+  return exact_eval(op.kind, bits ^ op.input_mask) != op.output_complement;
+}
+
+/*! \brief Looks for a chain of exactly `num_gates` gates computing `f`.
+ *
+ * Single-selection-variable encoding: every gate selects a strictly
+ * increasing tuple of earlier nodes and one normal operator; the
+ * simulation variables of the gates are constrained on all minterms but
+ * the all-zero one, on which every normal chain is 0.  Networks with
+ * three-input gates may select the constant, which turns a majority into
+ * an AND or OR and a three-input XOR into a two-input one.  `f` must be
+ * normal and not trivial.  Returns nullopt if there is no such chain and
+ * sets `gave_up` if the conflict limit was hit.
+ */
+inline std::optional<exact_chain> exact_chain_of_size(kitty::dynamic_truth_table const &f,
+                                                      exact_basis basis, uint32_t num_gates,
+                                                      uint32_t conflict_limit, bool &gave_up) {
+  using bill::lit_type;
+  const auto n = f.num_vars();
+  const auto arity = exact_arity(basis);
+  const auto ops = exact_ops(basis);
+  const auto num_minterms = 1u << n;
+  const auto first = arity == 3u ? 0u : 1u;
+
+  bill::solver<bill::solvers::ghack> solver;
+  auto pos = [](bill::var_type v) { return lit_type(v, lit_type::polarities::positive); };
+  auto neg = [](bill::var_type v) { return lit_type(v, lit_type::polarities::negative); };
+
+  /* sim[g][t] simulates gate g on minterm t, index 0 is unused */
+  std::vector<std::vector<bill::var_type>> sim(num_gates);
+  std::vector<std::vector<bill::var_type>> fun(num_gates);
+  std::vector<std::vector<bill::var_type>> op(num_gates);
+  std::vector<std::vector<std::pair<std::array<uint32_t, 3>, bill::var_type>>> sel(num_gates);
+  std::vector<std::vector<lit_type>> used(num_gates);
+
+  for (auto g = 0u; g < num_gates; ++g) {
+    sim[g].resize(num_minterms);
+    for (auto t = 1u; t < num_minterms; ++t) {
+      sim[g][t] = solver.add_variable();
+    }
+    fun[g].resize(1u << arity);
+    for (auto b = 1u; b < (1u << arity); ++b) {
+      fun[g][b] = solver.add_variable();
+    }
+
+    /* the operator fixes the gate function */
+    std::vector<lit_type> some_op;
+    for (auto const &o : ops) {
+      const auto v = solver.add_variable();
+      op[g].push_back(v);
+      some_op.push_back(pos(v));
+      for (auto b = 1u; b < (1u << arity); ++b) {
+        solver.add_clause(std::vector<lit_type>{neg(v), exact_eval(o, b) ? pos(fun[g][b]) : neg(fun[g][b])});
+      }
+    }
+    solver.add_clause(some_op);
+
+    /* fanin tuples over the constant, the inputs and the earlier gates */
+    const auto last = n + g;
+    std::array<uint32_t, 3> tuple{};
+    std::vector<lit_type> some_tuple;
+    auto add_tuple = [&]() {
+      const auto s = solver.add_variable();
+      sel[g].emplace_back(tuple, s);
+      some_tuple.push_back(pos(s));
+      for (auto q = 0u; q < arity; ++q) {
+        if (tuple[q] > n) {
+          used[tuple[q] - n - 1u].push_back(pos(s));
+        }
+      }
+    };
+    for (tuple[0] = first; tuple[0] <= last; ++tuple[0]) {
+      for (tuple[1] = tuple[0] + 1u; tuple[1] <= last; ++tuple[1]) {
+        if (arity == 2u) {
+          add_tuple();
+          continue;
+        }
+        for (tuple[2] = tuple[1] + 1u; tuple[2] <= last; ++tuple[2]) {
+          add_tuple();
+        }
+      }
+    }
+    if (some_tuple.empty()) {
+      return std::nullopt;
+    }
+    solver.add_clause(some_tuple);
+  }
+
+  /* the gate value follows its function under the selected fanins */
+  for (auto g = 0u; g < num_gates; ++g) {
+    for (auto const &[tuple, s] : sel[g]) {
+      for (auto t = 1u; t < num_minterms; ++t) {
+        for (auto b = 0u; b < (1u << arity); ++b) {
+          std::vector<lit_type> premise{neg(s)};
+          bool satisfied = false;
+          for (auto q = 0u; q < arity && !satisfied; ++q) {
+            const auto bit = ((b >> q) & 1u) != 0u;
+            const auto node = tuple[q];
+            if (node == 0u) {
+              satisfied = bit;
+            } else if (node <= n) {
+              satisfied = (((t >> (node - 1u)) & 1u) != 0u) != bit;
+            } else {
+              const auto v = sim[node - n - 1u][t];
+              premise.push_back(bit ? neg(v) : pos(v));
+            }
+          }
+          if (satisfied) {
+            continue;
+          }
+
+          auto clause = premise;
+          clause.push_back(neg(sim[g][t]));
+          if (b != 0u) {
+            clause.push_back(pos(fun[g][b]));
+          }
+          solver.add_clause(clause);
+          if (b != 0u) {
+            premise.push_back(pos(sim[g][t]));
+            premise.push_back(neg(fun[g][b]));
+            solver.add_clause(premise);
+          }
+        }
+      }
+    }
+  }
+
+  /* the last gate is the output, every other gate has a user */
+  for (auto t = 1u; t < num_minterms; ++t) {
+    const auto v = sim[num_gates - 1u][t];
+    solver.add_clause(std::vector<lit_type>{kitty::get_bit(f, t) ? pos(v) : neg(v)});
+  }
+  for (auto g = 0u; g + 1u < num_gates; ++g) {
+    solver.add_clause(used[g]);
+  }
+
+  const auto result = solver.solve({}, conflict_limit);
+  if (result == bill::result::states::undefined) {
+    gave_up = true;
+    return std::nullopt;
+  }
+  if (result != bill::result::states::satisfiable) {
+    return std::nullopt;
+  }
+
+  const auto model = solver.get_model().model();
+  auto is_true = [&](bill::var_type v) { return model.at(v) == bill::lbool_type::true_; };
+
+  exact_chain chain;
+  chain.num_vars = n;
+  std::vector<uint32_t> literal(1u + n + num_gates);
+  for (auto i = 0u; i <= n; ++i) {
+    literal[i] = 2u * i;
+  }
+  for (auto g = 0u; g < num_gates; ++g) {
+    auto const &o = ops[std::distance(op[g].begin(), std::find_if(op[g].begin(), op[g].end(), is_true))];
+    auto const &tuple = std::find_if(sel[g].begin(), sel[g].end(),
+                                     [&](auto const &ts) { return is_true(ts.second); })->first;
+    exact_gate gate{o.kind, {0u, 0u, 0u}};
+    for (auto q = 0u; q < arity; ++q) {
+      gate.fanins[q] = literal[tuple[q]] ^ ((o.input_mask >> q) & 1u);
+    }
+    chain.gates.push_back(gate);
+    literal[n + 1u + g] = 2u * (n + 1u + g) + (o.output_complement ? 1u : 0u);
+  }
+  chain.output = literal[n + num_gates];
+  return chain;
+}
+
+}  // namespace detail
+
+/*! \brief Size-optimal chain of `basis` gates computing `function`.
+ *
+ * Chains of increasing size are tried until one exists; returns nullopt
+ * if more than `max_gates` gates are needed or the conflict limit is hit.
+ * Constants and projections need no gates.
+ */
+inline std::optional<exact_chain> exact_synthesize(kitty::dynamic_truth_table const &function,
+                                                   exact_basis basis,
+                                                   exact_synthesis_params const &ps = {}) {
+  const auto n = function.num_vars();
+  const bool complemented = kitty::get_bit(function, 0);
+  const auto f = complemented ? ~function : function;
+
+  exact_chain chain;
+  chain.num_vars = n;
+  if (kitty::is_const0(f)) {
+    chain.output = complemented ? 1u : 0u;
+    return chain;
+  }
+  for (auto i = 0u; i < n; ++i) {
+    auto var = f.construct();
+    kitty::create_nth_var(var, i);
+    if (f == var) {
+      chain.output = 2u * (i + 1u) + (complemented ? 1u : 0u);
+      return chain;
+    }
+  }
+
+  for (auto size = 1u; size <= ps.max_gates; ++size) {
+    bool gave_up = false;
+    if (auto c = detail::exact_chain_of_size(f, basis, size, ps.conflict_limit, gave_up)) {
+      c->output ^= complemented ? 1u : 0u;
+      return c;
+    }
+    if (gave_up) {
+      break;
+    }
+  }
+  return std::nullopt;
+}
+
+/* The function computed by a chain. */
+inline kitty::dynamic_truth_table simulate_chain(exact_chain const &chain) {
+  std::vector<kitty::dynamic_truth_table> tts(1u + chain.num_vars + chain.gates.size(),
+                                              kitty::dynamic_truth_table(chain.num_vars));
+  for (auto i = 0u; i < chain.num_vars; ++i) {
+    kitty::create_nth_var(tts[i + 1u], i);
+  }
+  auto tt_of = [&](uint32_t lit) { return (lit & 1u) ? ~tts[lit >> 1u] : tts[lit >> 1u]; };
+  for (auto g = 0u; g < chain.gates.size(); ++g) {
+    auto const &gate = chain.gates[g];
+    auto &tt = tts[chain.num_vars + 1u + g];
+    switch (gate.kind) {
+      case exact_gate_kind::and2:
+        tt = tt_of(gate.fanins[0]) & tt_of(gate.fanins[1]);
+        break;
+      case exact_gate_kind::xor2:
+        tt = tt_of(gate.fanins[0]) ^ tt_of(gate.fanins[1]);
+        break;
+      case exact_gate_kind::maj3:
+        tt = kitty::ternary_majority(tt_of(gate.fanins[0]), tt_of(gate.fanins[1]),
+                                     tt_of(gate.fanins[2]));
+        break;
+      case exact_gate_kind::xor3:
+        tt = tt_of(gate.fanins[0]) ^ tt_of(gate.fanins[1]) ^ tt_of(gate.fanins[2]);
+        break;
+    }
+  }
+  return tt_of(chain.output);
+}
+
+/*! \brief Builds the chain in `ntk` over `leaves`, one per chain input.
+ *
+ * Returns the output signal.  Gates missing in `Ntk` are decomposed by the
+ * network's own constructors, e.g. a majority in an AIG.
+ */
+template <class Ntk>
+typename Ntk::signal instantiate_chain(Ntk &ntk, exact_chain const &chain,
+                                       std::vector<typename Ntk::signal> const &leaves) {
+  using signal = typename Ntk::signal;
+  std::vector<signal> sigs;
+  sigs.reserve(1u + chain.num_vars + chain.gates.size());
+  sigs.push_back(ntk.get_constant(false));
+  sigs.insert(sigs.end(), leaves.begin(), leaves.begin() + chain.num_vars);
+
+  auto sig_of = [&](uint32_t lit) {
+    return (lit & 1u) ? ntk.create_not(sigs[lit >> 1u]) : sigs[lit >> 1u];
+  };
+  for (auto const &gate : chain.gates) {
+    const auto a = sig_of(gate.fanins[0]), b = sig_of(gate.fanins[1]);
+    switch (gate.kind) {
+      case exact_gate_kind::and2:
+        sigs.push_back(ntk.create_and(a, b));
+        break;
+      case exact_gate_kind::xor2:
+        sigs.push_back(ntk.create_xor(a, b));
+        break;
+      case exact_gate_kind::maj3:
+        sigs.push_back(ntk.create_maj(a, b, sig_of(gate.fanins[2])));
+        break;
+      case exact_gate_kind::xor3:
+        if constexpr (mockturtle::has_create_xor3_v<Ntk>) {
+          sigs.push_back(ntk.create_xor3(a, b, sig_of(gate.fanins[2])));
+        } else {
+          sigs.push_back(ntk.create_xor(ntk.create_xor(a, b), sig_of(gate.fanins[2])));
+        }
+        break;
+    }
+  }
+  return sig_of(chain.output);
+}
+
+/*! \brief The chain as an expression in the syntax of
+ * `kitty::create_from_expression`, with inputs a, b, c, ...
+ *
+ * Shared gates are repeated.  A majority with a constant fanin is written
+ * as AND or OR, a three-input XOR with a constant fanin as two-input XOR.
+ */
+inline std::string chain_to_expression(exact_chain const &chain) {
+  std::vector<std::string> exprs(1u + chain.num_vars + chain.gates.size());
+  for (auto i = 0u; i < chain.num_vars; ++i) {
+    exprs[i + 1u] = std::string(1u, static_cast<char>('a' + i));
+  }
+  auto expr_of = [&](uint32_t lit) { return ((lit & 1u) ? "!" : "") + exprs[lit >> 1u]; };
+
+  for (auto g = 0u; g < chain.gates.size(); ++g) {
+    auto const &gate = chain.gates[g];
+    auto &expr = exprs[chain.num_vars + 1u + g];
+    const auto fs = gate.fanins;
+    if (gate.kind == exact_gate_kind::and2) {
+      expr = "(" + expr_of(fs[0]) + expr_of(fs[1]) + ")";
+    } else if (gate.kind == exact_gate_kind::xor2) {
+      expr = "[" + expr_of(fs[0]) + expr_of(fs[1]) + "]";
+    } else if ((fs[0] >> 1u) != 0u) {
+      expr = gate.kind == exact_gate_kind::maj3
+                 ? "<" + expr_of(fs[0]) + expr_of(fs[1]) + expr_of(fs[2]) + ">"
+                 : "[[" + expr_of(fs[0]) + expr_of(fs[1]) + "]" + expr_of(fs[2]) + "]";
+    } else if (gate.kind == exact_gate_kind::maj3) {
+      /* the constant is always the first fanin */
+      expr = ((fs[0] & 1u) ? "{" : "(") + expr_of(fs[1]) + expr_of(fs[2]) + ((fs[0] & 1u) ? "}" : ")");
+    } else {
+      expr = ((fs[0] & 1u) ? "![" : "[") + expr_of(fs[1]) + expr_of(fs[2]) + "]";
+    }
+  }
+
+  if ((chain.output >> 1u) == 0u) {
+    return (chain.output & 1u) ? "1" : "0";
+  }
+  return expr_of(chain.output);
+}
+
+/*! \brief Process-wide cache of exact chains keyed by basis and NPN class.
+ *
+ * All member functions are thread-safe.  A class being synthesized by one
+ * thread is waited for by the others instead of being synthesized twice;
+ * classes that gave up are not kept, so they are retried with other
+ * parameters.
+ */
+class exact_npn_cache {
+  using result_t = std::shared_future<std::optional<exact_chain>>;
+  using map_t = std::unordered_map<kitty::dynamic_truth_table, result_t,
+                                   kitty::hash<kitty::dynamic_truth_table>>;
+
+ public:
+  static exact_npn_cache &instance() {
+    static exact_npn_cache cache;
+    return cache;
+  }
+
+  std::optional<exact_chain> get(kitty::dynamic_truth_table const &representative,
+                                 exact_basis basis, exact_synthesis_params const &ps) {
+    auto &map = maps_[static_cast<uint32_t>(basis)];
+    std::promise<std::optional<exact_chain>> promise;
+    result_t result;
+    bool owner = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (auto it = map.find(representative); it != map.end()) {
+        ++hits_;
+        result = it->second;
+      } else {
+        ++misses_;
+        result = promise.get_future().share();
+        map.emplace(representative, result);
+        owner = true;
+      }
+    }
+    if (!owner) {
+      return result.get();
+    }
+
+    std::optional<exact_chain> chain;
+    try {
+      chain = exact_synthesize(representative, basis, ps);
+    } catch (...) {
+    }
+    promise.set_value(chain);
+    if (!chain) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      map.erase(representative);
+    }
+    return chain;
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &map : maps_) {
+      map.clear();
+    }
+    hits_ = misses_ = 0u;
+  }
+
+  std::size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t size = 0u;
+    for (auto const &map : maps_) {
+      size += map.size();
+    }
+    return size;
+  }
+
+  uint64_t hits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+  }
+
+  uint64_t misses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+  }
+
+ private:
+  exact_npn_cache() = default;
+
+ private:
+  mutable std::mutex mutex_;
+  std::array<map_t, 4u> maps_;
+  uint64_t hits_ = 0u;
+  uint64_t misses_ = 0u;
+};
+
+/*! \brief Exact chain of `function` through the NPN cache.
+ *
+ * Functions with up to `max_npn_vars` inputs are canonized and the chain of
+ * their representative is instantiated with permuted and complemented
+ * inputs, as in `npn_cached_resynthesis`; larger ones are cached as they
+ * are, since exact canonization is too slow for them.
+ */
+inline std::optional<exact_chain> exact_synthesize_cached(kitty::dynamic_truth_table const &function,
+                                                          exact_basis basis,
+                                                          exact_synthesis_params const &ps = {},
+                                                          uint32_t max_npn_vars = 6u) {
+  const auto n = function.num_vars();
+  if (n == 0u || n > max_npn_vars) {
+    return exact_npn_cache::instance().get(function, basis, ps);
+  }
+
+  const auto [canon, phase, perm] = fast_exact_npn_canonization(function);
+  auto chain = exact_npn_cache::instance().get(canon, basis, ps);
+  if (!chain) {
+    return std::nullopt;
+  }
+
+  auto map = [&](uint32_t lit) {
+    const auto index = lit >> 1u;
+    if (index == 0u || index > n) {
+      return lit;
+    }
+    const auto i = perm[index - 1u];
+    return (2u * (i + 1u)) ^ (lit & 1u) ^ ((phase >> i) & 1u);
+  };
+  for (auto &gate : chain->gates) {
+    for (auto &f : gate.fanins) {
+      f = map(f);
+    }
+  }
+  chain->output = map(chain->output) ^ ((phase >> n) & 1u);
+  return chain;
+}
+
+}  // namespace MagicLS
+
+#endif
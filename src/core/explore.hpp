@@ -0,0 +1,355 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file explore.hpp
+ *
+ * @brief  Parallel search over sequences of optimization transforms
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/25
+ */
+
+#ifndef EXPLORE_HPP
+#define EXPLORE_HPP
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <mockturtle/algorithms/lut_mapping.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/views/depth_view.hpp>
+#include <mockturtle/views/mapping_view.hpp>
+
+#include "./abc.hpp"
+#include "./network_opt.hpp"
+#include "./struct_hash.hpp"
+#include "./thread_pool.hpp"
+
+namespace MagicLS {
+
+/*! \brief A step of an explored script.
+ *
+ * ABC steps run an ABC9 script through the global frame and are serialized
+ * by `abc_mutex()`; the other steps run concurrently.
+ */
+struct explore_transform {
+  std::string name;
+  bool uses_abc = false;
+  std::function<mockturtle::aig_network(mockturtle::aig_network const &)> run;
+};
+
+inline std::vector<explore_transform> default_transforms() {
+  using mockturtle::aig_network;
+  std::vector<explore_transform> ts;
+  ts.push_back({"rewrite", false, [](aig_network const &aig) {
+                  mockturtle::cut_rewriting_params ps;
+                  ps.cut_enumeration_ps.cut_size = 4u;
+                  return cut_rewrite(aig, ps);
+                }});
+  ts.push_back({"resub", false, [](aig_network const &aig) {
+                  mockturtle::resubstitution_params ps;
+                  return resubstitute(aig, ps);
+                }});
+  ts.push_back({"refactor", false, [](aig_network const &aig) {
+                  mockturtle::refactoring_params ps;
+                  return refactor(aig, ps);
+                }});
+  ts.push_back({"balance", false, [](aig_network const &aig) {
+                  mockturtle::balancing_params ps;
+                  ps.cut_enumeration_ps.cut_size = 4u;
+                  return sop_balance(aig, ps);
+                }});
+  for (auto script : {"&b", "&dc2", "&syn2", "&syn3"}) {
+    ts.push_back({script, true, [script](aig_network const &aig) {
+                    return mockturtle::call_abc_script(aig, script);
+                  }});
+  }
+  return ts;
+}
+
+enum class explore_metric { luts, levels, gates };
+
+/* Costs compare lexicographically, the primary one is the pruned metric. */
+using explore_cost = std::pair<uint32_t, uint32_t>;
+
+inline explore_cost explore_evaluate(mockturtle::aig_network const &aig,
+                                     explore_metric metric) {
+  const auto depth = mockturtle::depth_view<mockturtle::aig_network>{aig}.depth();
+  switch (metric) {
+    case explore_metric::luts: {
+      mockturtle::aig_network copy = aig;
+      mockturtle::mapping_view<mockturtle::aig_network> mapped{copy};
+      mockturtle::lut_mapping_params ps;
+      ps.cut_enumeration_ps.cut_size = 6u;
+      mockturtle::lut_mapping(mapped, ps);
+      return {mapped.num_cells(), depth};
+    }
+    case explore_metric::levels:
+      return {depth, aig.num_gates()};
+    default:
+      return {aig.num_gates(), depth};
+  }
+}
+
+/* Resident set size of the process in MiB, 0 if unknown. */
+inline uint64_t resident_memory_mb() {
+  std::ifstream statm("/proc/self/statm");
+  uint64_t pages = 0u, resident = 0u;
+  if (!(statm >> pages >> resident)) {
+    return 0u;
+  }
+  return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE)) >> 20u;
+}
+
+enum class explore_strategy { beam, random, bandit };
+
+struct explore_params {
+  explore_strategy strategy = explore_strategy::beam;
+  explore_metric metric = explore_metric::luts;
+  /* candidates kept per beam step */
+  uint32_t beam_width = 4u;
+  /* maximum script length of beam and random search */
+  uint32_t depth = 6u;
+  /* scripts tried by random search */
+  uint32_t restarts = 16u;
+  /* batches of transforms tried by the bandit */
+  uint32_t rounds = 16u;
+  uint32_t num_threads = 0u;
+  /* wall time and resident memory budgets, 0 for none */
+  double time_budget = 60.0;
+  uint64_t memory_budget_mb = 0u;
+  uint32_t seed = 1u;
+  bool verbose = false;
+};
+
+struct explore_result {
+  mockturtle::aig_network network;
+  std::vector<std::string> script;
+  explore_cost initial_cost;
+  explore_cost cost;
+  uint32_t evaluated = 0u;
+  bool budget_exhausted = false;
+};
+
+/*! \brief Searches for the script with the lowest cost.
+ *
+ * Every evaluation applies one transform to a copy of an explored network,
+ * so candidates sharing a prefix share its work.  The budgets are checked
+ * before each batch and before each evaluation, an evaluation in flight is
+ * finished.
+ */
+class explorer {
+  struct candidate {
+    mockturtle::aig_network network;
+    std::vector<std::string> script;
+    explore_cost cost;
+    uint64_t hash = 0u;
+  };
+
+ public:
+  explorer(explore_params const &ps, std::vector<explore_transform> transforms)
+      : ps_(ps), transforms_(std::move(transforms)), pool_(ps.num_threads),
+        rng_(ps.seed) {}
+
+  explore_result run(mockturtle::aig_network const &aig) {
+    start_ = std::chrono::steady_clock::now();
+    best_ = {aig, {}, explore_evaluate(aig, ps_.metric), structural_hash(aig)};
+    initial_cost_ = best_.cost;
+
+    switch (ps_.strategy) {
+      case explore_strategy::beam:
+        beam_search();
+        break;
+      case explore_strategy::random:
+        random_restarts();
+        break;
+      case explore_strategy::bandit:
+        bandit();
+        break;
+    }
+
+    return {best_.network, best_.script, initial_cost_, best_.cost, evaluated_,
+            exhausted_.load()};
+  }
+
+ private:
+  bool over_budget() {
+    if (exhausted_) {
+      return true;
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_;
+    if ((ps_.time_budget > 0.0 && elapsed.count() > ps_.time_budget) ||
+        (ps_.memory_budget_mb > 0u && resident_memory_mb() > ps_.memory_budget_mb)) {
+      exhausted_ = true;
+    }
+    return exhausted_;
+  }
+
+  std::future<std::optional<candidate>> apply(candidate const &parent, uint32_t t) {
+    return pool_.submit([this, &parent, t]() -> std::optional<candidate> {
+      if (over_budget()) {
+        return std::nullopt;
+      }
+      auto const &tr = transforms_[t];
+      /* the parent is shared by concurrent evaluations, work on a copy */
+      auto input = parent.network.clone();
+      try {
+        std::unique_lock<std::mutex> lock(abc_mutex(), std::defer_lock);
+        if (tr.uses_abc) {
+          lock.lock();
+        }
+        auto network = tr.run(input);
+        if (lock.owns_lock()) {
+          lock.unlock();
+        }
+
+        candidate c{network, parent.script, explore_evaluate(network, ps_.metric),
+                    structural_hash(network)};
+        c.script.push_back(tr.name);
+        return c;
+      } catch (...) {
+        return std::nullopt;
+      }
+    });
+  }
+
+  void consider(candidate const &c) {
+    ++evaluated_;
+    if (c.cost < best_.cost) {
+      best_ = c;
+      if (ps_.verbose) {
+        std::cout << fmt::format("[i] explore: ({}, {}) with {}\n", c.cost.first,
+                                 c.cost.second, join(c.script));
+      }
+    }
+  }
+
+  /* expands every beam entry with every transform and keeps the best
+   * `beam_width` distinct networks */
+  void beam_search() {
+    std::vector<candidate> beam{best_};
+    std::unordered_set<uint64_t> seen{best_.hash};
+    for (auto step = 0u; step < ps_.depth && !beam.empty() && !over_budget(); ++step) {
+      std::vector<std::future<std::optional<candidate>>> futures;
+      for (auto const &b : beam) {
+        for (auto t = 0u; t < transforms_.size(); ++t) {
+          futures.push_back(apply(b, t));
+        }
+      }
+
+      std::vector<candidate> next;
+      for (auto &f : futures) {
+        if (auto c = f.get(); c && seen.insert(c->hash).second) {
+          consider(*c);
+          next.push_back(std::move(*c));
+        }
+      }
+      std::sort(next.begin(), next.end(),
+                [](auto const &a, auto const &b) { return a.cost < b.cost; });
+      if (next.size() > ps_.beam_width) {
+        next.resize(ps_.beam_width);
+      }
+      beam = std::move(next);
+    }
+  }
+
+  /* random scripts of length `depth` run concurrently, one step at a time */
+  void random_restarts() {
+    std::uniform_int_distribution<uint32_t> pick(0u, transforms_.size() - 1u);
+    std::vector<candidate> walkers(ps_.restarts, best_);
+    for (auto step = 0u; step < ps_.depth && !over_budget(); ++step) {
+      std::vector<std::future<std::optional<candidate>>> futures;
+      for (auto const &w : walkers) {
+        futures.push_back(apply(w, pick(rng_)));
+      }
+      for (auto i = 0u; i < walkers.size(); ++i) {
+        if (auto c = futures[i].get()) {
+          consider(*c);
+          walkers[i] = std::move(*c);
+        }
+      }
+    }
+  }
+
+  /* UCB1 over the transforms; every round applies the most promising
+   * ones to the best network in parallel, the reward is the relative
+   * decrease of the primary cost */
+  void bandit() {
+    const auto num_arms = static_cast<uint32_t>(transforms_.size());
+    const auto batch = std::min(num_arms, std::max(1u, pool_.size()));
+    std::vector<double> reward(num_arms, 0.0);
+    std::vector<uint32_t> pulls(num_arms, 0u);
+    uint32_t total = 0u;
+
+    for (auto round = 0u; round < ps_.rounds && !over_budget(); ++round) {
+      std::vector<std::pair<double, uint32_t>> scores;
+      for (auto a = 0u; a < num_arms; ++a) {
+        const auto score = pulls[a] == 0u
+                               ? std::numeric_limits<double>::infinity()
+                               : reward[a] / pulls[a] +
+                                     std::sqrt(2.0 * std::log(total + 1.0) / pulls[a]);
+        scores.emplace_back(score, a);
+      }
+      std::stable_sort(scores.begin(), scores.end(),
+                       [](auto const &x, auto const &y) { return x.first > y.first; });
+
+      const auto parent = best_;
+      std::vector<std::future<std::optional<candidate>>> futures;
+      for (auto i = 0u; i < batch; ++i) {
+        futures.push_back(apply(parent, scores[i].second));
+      }
+      for (auto i = 0u; i < batch; ++i) {
+        const auto arm = scores[i].second;
+        ++pulls[arm];
+        ++total;
+        if (auto c = futures[i].get()) {
+          const auto before = static_cast<double>(std::max(parent.cost.first, 1u));
+          reward[arm] += std::max(0.0, (before - c->cost.first) / before);
+          consider(*c);
+        }
+      }
+    }
+  }
+
+  static std::string join(std::vector<std::string> const &script) {
+    std::string s;
+    for (auto const &step : script) {
+      s += (s.empty() ? "" : "; ") + step;
+    }
+    return s;
+  }
+
+ private:
+  explore_params ps_;
+  std::vector<explore_transform> transforms_;
+  thread_pool pool_;
+  std::mt19937 rng_;
+  std::chrono::steady_clock::time_point start_;
+  std::atomic<bool> exhausted_{false};
+  candidate best_;
+  explore_cost initial_cost_;
+  uint32_t evaluated_ = 0u;
+};
+
+}  // namespace MagicLS
+
+#endif
@@ -0,0 +1,238 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file expression.hpp
+ *
+ * @brief  Compile Boolean expressions over named variables into AIGs/XAGs
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/31
+ */
+
+#ifndef EXPRESSION_HPP
+#define EXPRESSION_HPP
+
+#include <cctype>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/xag.hpp>
+
+namespace MagicLS {
+
+/*! \brief Recursive-descent compiler of infix Boolean expressions.
+ *
+ * Grammar, from the lowest precedence:
+ *
+ *     expr    := xor ('|' xor)*
+ *     xor     := and ('^' and)*
+ *     and     := unary ('&' unary)*
+ *     unary   := ('!' | '~') unary | primary
+ *     primary := '(' expr ')' | '0' | '1' | name
+ *              | ('maj' | 'ite') '(' expr ',' expr ',' expr ')'
+ *
+ * Names are identifiers ([A-Za-z_][A-Za-z0-9_.]* and bus bits such as
+ * `data[3]`); every new name becomes the next primary input.  The gates are
+ * built with the network's own constructors, so the result is structurally
+ * hashed while it is parsed.  Errors throw `std::invalid_argument`.
+ */
+template <class Ntk>
+class expression_compiler {
+  using signal = typename Ntk::signal;
+
+ public:
+  explicit expression_compiler(std::string const &text) : text_(text) {}
+
+  Ntk compile() {
+    const auto f = parse_or();
+    skip_blanks();
+    if (pos_ != text_.size()) {
+      fail("unexpected character");
+    }
+    ntk_.create_po(f);
+    return ntk_;
+  }
+
+  /* input names in the order of the primary inputs */
+  std::vector<std::string> const &inputs() const { return names_; }
+
+ private:
+  signal parse_or() {
+    auto f = parse_xor();
+    while (accept('|')) {
+      f = ntk_.create_or(f, parse_xor());
+    }
+    return f;
+  }
+
+  signal parse_xor() {
+    auto f = parse_and();
+    while (accept('^')) {
+      f = ntk_.create_xor(f, parse_and());
+    }
+    return f;
+  }
+
+  signal parse_and() {
+    auto f = parse_unary();
+    while (accept('&')) {
+      f = ntk_.create_and(f, parse_unary());
+    }
+    return f;
+  }
+
+  signal parse_unary() {
+    if (accept('!') || accept('~')) {
+      return ntk_.create_not(parse_unary());
+    }
+    return parse_primary();
+  }
+
+  signal parse_primary() {
+    if (accept('(')) {
+      const auto f = parse_or();
+      expect(')');
+      return f;
+    }
+    if (accept('0')) {
+      return ntk_.get_constant(false);
+    }
+    if (accept('1')) {
+      return ntk_.get_constant(true);
+    }
+
+    const auto name = parse_name();
+    if ((name == "maj" || name == "ite") && accept('(')) {
+      const auto a = parse_or();
+      expect(',');
+      const auto b = parse_or();
+      expect(',');
+      const auto c = parse_or();
+      expect(')');
+      return name == "maj" ? ntk_.create_maj(a, b, c) : ntk_.create_ite(a, b, c);
+    }
+
+    if (auto it = inputs_.find(name); it != inputs_.end()) {
+      return it->second;
+    }
+    names_.push_back(name);
+    return inputs_[name] = ntk_.create_pi();
+  }
+
+  std::string parse_name() {
+    skip_blanks();
+    const auto begin = pos_;
+    if (pos_ < text_.size() && (std::isalpha(static_cast<unsigned char>(text_[pos_])) || text_[pos_] == '_')) {
+      ++pos_;
+      while (pos_ < text_.size() && (std::isalnum(static_cast<unsigned char>(text_[pos_])) ||
+                                     text_[pos_] == '_' || text_[pos_] == '.')) {
+        ++pos_;
+      }
+      /* bus bits */
+      if (pos_ < text_.size() && text_[pos_] == '[') {
+        const auto close = text_.find(']', pos_);
+        if (close == std::string::npos) {
+          fail("unterminated bus index");
+        }
+        pos_ = close + 1u;
+      }
+    }
+    if (pos_ == begin) {
+      fail("expected a variable, a constant or '('");
+    }
+    return text_.substr(begin, pos_ - begin);
+  }
+
+  void skip_blanks() {
+    while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+      ++pos_;
+    }
+  }
+
+  /* constants must not be the start of a name such as `1st` */
+  bool accept(char c) {
+    skip_blanks();
+    if (pos_ >= text_.size() || text_[pos_] != c) {
+      return false;
+    }
+    if ((c == '0' || c == '1') && pos_ + 1u < text_.size() &&
+        (std::isalnum(static_cast<unsigned char>(text_[pos_ + 1u])) || text_[pos_ + 1u] == '_')) {
+      return false;
+    }
+    ++pos_;
+    return true;
+  }
+
+  void expect(char c) {
+    if (!accept(c)) {
+      fail(fmt::format("expected '{}'", c));
+    }
+  }
+
+  [[noreturn]] void fail(std::string const &what) const {
+    throw std::invalid_argument(fmt::format("{} at position {} of \"{}\"", what, pos_, text_));
+  }
+
+ private:
+  std::string text_;
+  std::size_t pos_ = 0u;
+  Ntk ntk_;
+  std::unordered_map<std::string, signal> inputs_;
+  std::vector<std::string> names_;
+};
+
+/*! \brief Bit-parallel simulation of the first output on random patterns.
+ *
+ * Every node holds `num_words` words, i.e. 64 patterns per word, so the
+ * cost is linear in the network size regardless of the number of inputs.
+ */
+template <class Ntk>
+std::vector<uint64_t> simulate_random_words(Ntk const &ntk, uint32_t num_words, uint64_t seed = 1u) {
+  std::mt19937_64 rng(seed);
+  std::vector<std::vector<uint64_t>> words(ntk.size(), std::vector<uint64_t>(num_words, 0u));
+  ntk.foreach_pi([&](auto const &n) {
+    for (auto &w : words[ntk.node_to_index(n)]) {
+      w = rng();
+    }
+  });
+
+  auto word_of = [&](auto const &f, uint32_t i) {
+    const auto w = words[ntk.node_to_index(ntk.get_node(f))][i];
+    return ntk.is_complemented(f) ? ~w : w;
+  };
+  ntk.foreach_gate([&](auto const &n) {
+    std::vector<typename Ntk::signal> fanins;
+    ntk.foreach_fanin(n, [&](auto const &f) { fanins.push_back(f); });
+    bool is_xor = false;
+    if constexpr (std::is_same_v<Ntk, mockturtle::xag_network>) {
+      is_xor = ntk.is_xor(n);
+    }
+    auto &out = words[ntk.node_to_index(n)];
+    for (auto i = 0u; i < num_words; ++i) {
+      out[i] = is_xor ? word_of(fanins[0], i) ^ word_of(fanins[1], i)
+                      : word_of(fanins[0], i) & word_of(fanins[1], i);
+    }
+  });
+
+  std::vector<uint64_t> result(num_words, 0u);
+  ntk.foreach_po([&](auto const &f, auto index) {
+    if (index == 0u) {
+      for (auto i = 0u; i < num_words; ++i) {
+        result[i] = word_of(f, i);
+      }
+    }
+  });
+  return result;
+}
+
+}  // namespace MagicLS
+
+#endif
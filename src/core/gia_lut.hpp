@@ -0,0 +1,96 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file gia_lut.hpp
+ *
+ * @brief  Extract the LUT mapping of a GIA into a k-LUT network
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/20
+ */
+
+#ifndef GIA_LUT_HPP
+#define GIA_LUT_HPP
+
+#include <aig/gia/gia.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <mockturtle/networks/klut.hpp>
+
+namespace MagicLS {
+
+/*! \brief k-LUT network of a GIA, without going through files.
+ *
+ * With a mapping (`&if`, `&lf`, ...) every LUT becomes a node whose function
+ * is computed by ABC over the LUT fanins; without one every AND becomes a
+ * two-input node.  Complemented outputs get an inverter node.
+ */
+inline mockturtle::klut_network gia_to_klut(pabc::Gia_Man_t *gia) {
+  using namespace pabc; /* the iteration macros use unqualified names */
+  using signal = mockturtle::klut_network::signal;
+
+  mockturtle::klut_network klut;
+  std::vector<signal> sig(Gia_ManObjNum(gia), klut.get_constant(false));
+  Gia_Obj_t *pObj;
+  int i;
+
+  Gia_ManForEachCi(gia, pObj, i) { sig[Gia_ObjId(gia, pObj)] = klut.create_pi(); }
+
+  if (Gia_ManHasMapping(gia)) {
+    Vec_Int_t *vLeaves = Vec_IntAlloc(16);
+    std::vector<signal> children;
+    int k, iFan;
+
+    Gia_ObjComputeTruthTableStart(gia, Gia_ManLutSizeMax(gia));
+    Gia_ManForEachLut(gia, i) {
+      Vec_IntClear(vLeaves);
+      children.clear();
+      Gia_LutForEachFanin(gia, i, iFan, k) {
+        Vec_IntPush(vLeaves, iFan);
+        children.push_back(sig[iFan]);
+      }
+
+      const auto num_vars = static_cast<uint32_t>(children.size());
+      const word *pTruth =
+          Gia_ObjComputeTruthTableCut(gia, Gia_ManObj(gia, i), vLeaves);
+      const auto num_words = num_vars <= 6u ? 1u : 1u << (num_vars - 6u);
+
+      kitty::dynamic_truth_table tt(num_vars);
+      kitty::create_from_words(tt, pTruth, pTruth + num_words);
+      tt.mask_bits(); /* ABC repeats small functions over the whole word */
+      sig[i] = klut.create_node(children, tt);
+    }
+    Gia_ObjComputeTruthTableStop(gia);
+    Vec_IntFree(vLeaves);
+  } else {
+    kitty::dynamic_truth_table a(2u), b(2u);
+    kitty::create_nth_var(a, 0u);
+    kitty::create_nth_var(b, 1u);
+
+    Gia_ManForEachAnd(gia, pObj, i) {
+      const auto fa = Gia_ObjFaninC0(pObj) ? ~a : a;
+      const auto fb = Gia_ObjFaninC1(pObj) ? ~b : b;
+      sig[i] = klut.create_node(
+          {sig[Gia_ObjFaninId0(pObj, i)], sig[Gia_ObjFaninId1(pObj, i)]}, fa & fb);
+    }
+  }
+
+  Gia_ManForEachCo(gia, pObj, i) {
+    const auto id = Gia_ObjFaninId0p(gia, pObj);
+    if (id == 0) {
+      klut.create_po(klut.get_constant(Gia_ObjFaninC0(pObj)));
+    } else {
+      klut.create_po(Gia_ObjFaninC0(pObj) ? klut.create_not(sig[id]) : sig[id]);
+    }
+  }
+  return klut;
+}
+
+}  // namespace MagicLS
+
+#endif
@@ -0,0 +1,305 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file library_manager.hpp
+ *
+ * @brief  Parse-once standard-cell libraries shared by ABC and mockturtle
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/17
+ */
+
+#ifndef LIBRARY_MANAGER_HPP
+#define LIBRARY_MANAGER_HPP
+
+#include <base/main/main.h>
+#include <map/amap/amap.h>
+#include <map/mapper/mapper.h>
+#include <map/mapper/mapperInt.h>
+#include <map/mio/mio.h>
+#include <map/super/super.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <lorina/genlib.hpp>
+#include <mockturtle/io/genlib_reader.hpp>
+#include <mockturtle/utils/tech_library.hpp>
+
+#include "./compressed_io.hpp"
+#include "./struct_hash.hpp"
+
+namespace MagicLS {
+
+/* cut size of the mockturtle matching tables */
+using cell_library = mockturtle::tech_library<6>;
+
+/*! \brief One standard-cell library in all the forms the mappers use.
+ *
+ * The genlib text is parsed once into mockturtle gates and into the ABC
+ * Mio/Amap libraries; the ABC supergate library and the mockturtle
+ * `tech_library` are derived on first use.  Entries are never freed, ABC
+ * may still point at them from its global frame.
+ */
+struct library_entry {
+  uint64_t hash = 0u;
+  std::string filename;
+  std::vector<mockturtle::gate> gates;
+
+  pabc::Mio_Library_t *mio = nullptr;
+  pabc::Amap_Lib_t *amap = nullptr;
+  pabc::Map_SuperLib_t *super = nullptr;
+
+  std::shared_ptr<cell_library> tech;
+  std::once_flag tech_once;
+};
+
+namespace detail {
+
+inline uint64_t content_hash(std::string const &text) {
+  uint64_t h = 0xcbf29ce484222325ull; /* FNV-1a */
+  for (unsigned char c : text) {
+    h = (h ^ c) * 0x100000001b3ull;
+  }
+  return mix(h);
+}
+
+inline uint64_t gates_hash(std::vector<mockturtle::gate> const &gates) {
+  std::hash<std::string> str;
+  std::hash<double> num;
+  uint64_t h = combine(0x9a7e5ull, gates.size());
+  for (auto const &g : gates) {
+    h = combine(h, str(g.name));
+    h = combine(h, str(g.expression));
+    h = combine(h, num(g.area));
+    for (auto const &p : g.pins) {
+      h = combine(h, num(p.rise_block_delay));
+      h = combine(h, num(p.fall_block_delay));
+    }
+  }
+  return h;
+}
+
+}  // namespace detail
+
+/*! \brief Process-wide registry of standard-cell libraries.
+ *
+ * Libraries are keyed by the hash of their genlib text: loading the same
+ * library again, or under another file name, reuses the parsed data.  All
+ * member functions are thread-safe.
+ *
+ * If the environment variable MAGICLS_LIBRARY_CACHE names a directory, the
+ * ABC supergates are stored there as `<hash>.super` and read back instead of
+ * being recomputed.  The mockturtle matching tables have no serialized form,
+ * they are built once per process.
+ */
+class library_manager {
+ public:
+  static library_manager &instance() {
+    static library_manager manager;
+    return manager;
+  }
+
+  /* Returns the library in `filename`, parsing it only if it is new. */
+  std::shared_ptr<library_entry> load(std::string const &filename,
+                                      bool verbose = false) {
+    const auto text = read_file_contents(filename);
+    const auto hash = detail::content_hash(text);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto it = by_text_.find(hash); it != by_text_.end()) {
+      if (verbose) {
+        std::cout << "[i] reusing library " << it->second->filename << "\n";
+      }
+      return it->second;
+    }
+
+    auto entry = std::make_shared<library_entry>();
+    entry->hash = hash;
+    entry->filename = filename;
+
+    std::istringstream in(text);
+    if (lorina::read_genlib(in, mockturtle::genlib_reader(entry->gates)) !=
+        lorina::return_code::success) {
+      throw std::runtime_error("cannot parse genlib " + filename);
+    }
+
+    /* both ABC readers take the text as a buffer and tokenize it in place */
+    std::string buffer = text;
+    entry->mio = pabc::Mio_LibraryRead((char *)filename.c_str(), buffer.data(),
+                                       nullptr, verbose);
+    if (entry->mio == nullptr) {
+      throw std::runtime_error("ABC cannot read genlib " + filename);
+    }
+    buffer = text;
+    entry->amap = pabc::Amap_LibReadAndPrepare((char *)filename.c_str(),
+                                               buffer.data(), 0, 0);
+
+    by_text_.emplace(hash, entry);
+    by_gates_.emplace(detail::gates_hash(entry->gates), entry);
+    return entry;
+  }
+
+  /* Makes `entry` the current library of the ABC frame. */
+  void activate(std::shared_ptr<library_entry> const &entry) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    /* plain setters, the previous libraries stay owned by their entries */
+    pabc::Abc_FrameSetLibGen(entry->mio);
+    pabc::Abc_FrameSetLibGen2(entry->amap);
+    pabc::Abc_FrameSetLibSuper(entry->super);
+    active_ = entry;
+  }
+
+  std::shared_ptr<library_entry> active() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return active_;
+  }
+
+  /*! \brief Supergates of the active library for `Abc_NtkMap`.
+   *
+   * Derived on first use (or read from the disk cache) and installed in the
+   * ABC frame, so the mapper does not derive them again.
+   */
+  void prepare_mapper(bool verbose = false) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!active_ || active_->super != nullptr) {
+      return;
+    }
+
+    auto &entry = *active_;
+    const auto cache_file = cache_dir_.empty()
+                                ? std::string()
+                                : cache_dir_ + "/" + hex(entry.hash) + ".super";
+    pabc::Vec_Str_t *vStr = read_supergates(cache_file);
+    if (vStr == nullptr) {
+      vStr = pabc::Super_PrecomputeStr(entry.mio, 5, 1, 100000000, 10000000,
+                                       10000000, 100, 1, 0);
+      if (vStr == nullptr) {
+        return;
+      }
+      write_supergates(cache_file, vStr);
+    } else if (verbose) {
+      std::cout << "[i] supergates read from " << cache_file << "\n";
+    }
+
+    entry.super = pabc::Map_SuperLibCreate(entry.mio, vStr,
+                                           (char *)entry.filename.c_str(),
+                                           nullptr, 1, 0);
+    pabc::Vec_StrFree(vStr);
+    pabc::Abc_FrameSetLibSuper(entry.super);
+  }
+
+  /* Adopts libraries ABC replaced in its frame while mapping. */
+  void sync_from_frame() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!active_) {
+      return;
+    }
+    active_->super = (pabc::Map_SuperLib_t *)pabc::Abc_FrameReadLibSuper();
+    active_->mio = (pabc::Mio_Library_t *)pabc::Abc_FrameReadLibGen();
+  }
+
+  /*! \brief Matching tables for `gates`, built once and shared. */
+  std::shared_ptr<cell_library> tech_library(
+      std::vector<mockturtle::gate> const &gates) {
+    std::shared_ptr<library_entry> entry;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      const auto hash = detail::gates_hash(gates);
+      auto it = by_gates_.find(hash);
+      if (it == by_gates_.end()) {
+        auto e = std::make_shared<library_entry>();
+        e->gates = gates;
+        it = by_gates_.emplace(hash, e).first;
+      }
+      entry = it->second;
+    }
+
+    std::call_once(entry->tech_once, [&]() {
+      entry->tech = std::make_shared<cell_library>(entry->gates);
+    });
+    return entry->tech;
+  }
+
+  uint32_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<uint32_t>(by_gates_.size());
+  }
+
+ private:
+  library_manager() {
+    if (const char *dir = std::getenv("MAGICLS_LIBRARY_CACHE")) {
+      cache_dir_ = dir;
+    }
+  }
+
+  static std::string hex(uint64_t value) {
+    std::ostringstream os;
+    os << std::hex << value;
+    return os.str();
+  }
+
+  static pabc::Vec_Str_t *read_supergates(std::string const &filename) {
+    if (filename.empty()) {
+      return nullptr;
+    }
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) {
+      return nullptr;
+    }
+    const std::string data((std::istreambuf_iterator<char>(in)),
+                           std::istreambuf_iterator<char>());
+    if (data.empty()) {
+      return nullptr;
+    }
+    char *pArray = ABC_ALLOC(char, data.size());
+    std::memcpy(pArray, data.data(), data.size());
+    return pabc::Vec_StrAllocArray(pArray, static_cast<int>(data.size()));
+  }
+
+  static void write_supergates(std::string const &filename,
+                               pabc::Vec_Str_t *vStr) {
+    if (filename.empty()) {
+      return;
+    }
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out.write(pabc::Vec_StrArray(vStr), pabc::Vec_StrSize(vStr));
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::unordered_map<uint64_t, std::shared_ptr<library_entry>> by_text_;
+  std::unordered_map<uint64_t, std::shared_ptr<library_entry>> by_gates_;
+  std::shared_ptr<library_entry> active_;
+  std::string cache_dir_;
+};
+
+/*! \brief Adopts the libraries of the ABC frame when leaving its scope.
+ *
+ * `Abc_NtkMap` may replace and free the supergate library of the frame
+ * even when mapping fails, so the sync must run on every return path.
+ */
+class frame_library_sync {
+ public:
+  frame_library_sync() = default;
+  frame_library_sync(frame_library_sync const &) = delete;
+  frame_library_sync &operator=(frame_library_sync const &) = delete;
+  ~frame_library_sync() { library_manager::instance().sync_from_frame(); }
+};
+
+}  // namespace MagicLS
+
+#endif
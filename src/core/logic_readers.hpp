@@ -0,0 +1,292 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file logic_readers.hpp
+ *
+ * @brief  BLIF and bench readers building AIGs and XAGs directly
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/15
+ */
+
+#ifndef LOGIC_READERS_HPP
+#define LOGIC_READERS_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/isop.hpp>
+#include <kitty/operations.hpp>
+#include <lorina/bench.hpp>
+#include <lorina/blif.hpp>
+#include <mockturtle/traits.hpp>
+
+namespace MagicLS {
+
+namespace detail {
+
+/* Builds gates of an AIG or XAG from covers and truth tables. */
+template <class Ntk>
+class logic_builder {
+ public:
+  using signal = typename Ntk::signal;
+
+  explicit logic_builder(Ntk &ntk) : ntk_(ntk) {}
+
+  /* `cubes` over `fanins`, the cover describes the on-set if `onset` */
+  signal sop(std::vector<signal> const &fanins,
+             std::vector<std::string> const &cubes, bool onset) {
+    /* parity functions become XOR chains (native gates in XAGs) */
+    if (fanins.size() >= 2u && fanins.size() <= 6u) {
+      kitty::dynamic_truth_table tt(static_cast<uint32_t>(fanins.size()));
+      for (auto const &cube : cubes) {
+        kitty::dynamic_truth_table c = ~tt.construct();
+        for (auto i = 0u; i < cube.size(); ++i) {
+          if (cube[i] == '-') {
+            continue;
+          }
+          auto var = tt.construct();
+          kitty::create_nth_var(var, i, cube[i] == '0');
+          c &= var;
+        }
+        tt |= c;
+      }
+      if (!onset) {
+        tt = ~tt;
+      }
+      if (auto x = parity(fanins, tt)) {
+        return *x;
+      }
+    }
+
+    std::vector<signal> products;
+    products.reserve(cubes.size());
+    for (auto const &cube : cubes) {
+      std::vector<signal> literals;
+      for (auto i = 0u; i < cube.size(); ++i) {
+        if (cube[i] == '1') {
+          literals.push_back(fanins[i]);
+        } else if (cube[i] == '0') {
+          literals.push_back(ntk_.create_not(fanins[i]));
+        }
+      }
+      products.push_back(ntk_.create_nary_and(literals));
+    }
+    const auto f = ntk_.create_nary_or(products);
+    return onset ? f : ntk_.create_not(f);
+  }
+
+  signal function(std::vector<signal> const &fanins,
+                  kitty::dynamic_truth_table const &tt) {
+    if (auto x = parity(fanins, tt)) {
+      return *x;
+    }
+
+    std::vector<std::string> cubes;
+    for (auto const &cube : kitty::isop(tt)) {
+      std::string s(fanins.size(), '-');
+      for (auto i = 0u; i < fanins.size(); ++i) {
+        if (cube.get_mask(i)) {
+          s[i] = cube.get_bit(i) ? '1' : '0';
+        }
+      }
+      cubes.push_back(s);
+    }
+    return sop(fanins, cubes, true);
+  }
+
+ private:
+  std::optional<signal> parity(std::vector<signal> const &fanins,
+                               kitty::dynamic_truth_table const &tt) {
+    if (fanins.size() < 2u) {
+      return std::nullopt;
+    }
+    auto odd = tt.construct();
+    for (auto i = 0u; i < fanins.size(); ++i) {
+      auto var = tt.construct();
+      kitty::create_nth_var(var, i);
+      odd ^= var;
+    }
+    if (tt != odd && tt != ~odd) {
+      return std::nullopt;
+    }
+    const auto x = ntk_.create_nary_xor(fanins);
+    return tt == odd ? x : ntk_.create_not(x);
+  }
+
+ private:
+  Ntk &ntk_;
+};
+
+}  // namespace detail
+
+/*! \brief lorina BLIF reader building an AIG or XAG.
+ *
+ * Every `.names` cover is turned into a balanced AND/OR tree, parity covers
+ * into XOR trees, all gates are structurally hashed on construction.  The
+ * outputs are created by `finalize()` once lorina has succeeded; signals
+ * that are used but never defined, such as latch outputs, make it fail.
+ */
+template <class Ntk>
+class logic_blif_reader : public lorina::blif_reader {
+ public:
+  using signal = typename Ntk::signal;
+
+  explicit logic_blif_reader(Ntk &ntk) : ntk_(ntk), builder_(ntk) {}
+
+  void on_input(const std::string &name) const override {
+    signals_[name] = ntk_.create_pi();
+  }
+
+  void on_output(const std::string &name) const override {
+    outputs_.push_back(name);
+  }
+
+  void on_gate(const std::vector<std::string> &inputs, const std::string &output,
+               const output_cover_t &cover) const override {
+    std::vector<signal> fanins;
+    fanins.reserve(inputs.size());
+    for (auto const &in : inputs) {
+      fanins.push_back(signal_of(in));
+    }
+
+    /* an empty cover is constant 0, a cover may list the on- or off-set */
+    if (cover.empty()) {
+      signals_[output] = ntk_.get_constant(false);
+      return;
+    }
+    const bool onset = cover.front().second == "1";
+    std::vector<std::string> cubes;
+    cubes.reserve(cover.size());
+    for (auto const &[cube, value] : cover) {
+      cubes.push_back(cube);
+    }
+    signals_[output] = builder_.sop(fanins, cubes, onset);
+  }
+
+  /* creates the outputs, false if a signal was used but never defined */
+  bool finalize() {
+    for (auto const &o : outputs_) {
+      ntk_.create_po(signal_of(o));
+    }
+    return !undefined_;
+  }
+
+ private:
+  signal signal_of(std::string const &name) const {
+    if (auto it = signals_.find(name); it != signals_.end()) {
+      return it->second;
+    }
+    std::cerr << "[e] undefined signal " << name << " (latches are not supported)\n";
+    undefined_ = true;
+    return ntk_.get_constant(false);
+  }
+
+ private:
+  Ntk &ntk_;
+  mutable detail::logic_builder<Ntk> builder_;
+  mutable std::unordered_map<std::string, signal> signals_;
+  mutable std::vector<std::string> outputs_;
+  mutable bool undefined_ = false;
+};
+
+/*! \brief lorina bench reader building an AIG or XAG.
+ *
+ * Supports AND, NAND, OR, NOR, XOR, XNOR, NOT, BUF(F), constant gates and
+ * hexadecimal LUTs (`0x...`).  The outputs are created by `finalize()` once
+ * lorina has succeeded; undefined signals make it fail.
+ */
+template <class Ntk>
+class logic_bench_reader : public lorina::bench_reader {
+ public:
+  using signal = typename Ntk::signal;
+
+  explicit logic_bench_reader(Ntk &ntk) : ntk_(ntk), builder_(ntk) {}
+
+  /* creates the outputs, false if a signal was used but never defined */
+  bool finalize() {
+    for (auto const &o : outputs_) {
+      ntk_.create_po(signal_of(o));
+    }
+    return !undefined_;
+  }
+
+  void on_input(const std::string &name) const override {
+    signals_[name] = ntk_.create_pi();
+  }
+
+  void on_output(const std::string &name) const override {
+    outputs_.push_back(name);
+  }
+
+  void on_assign(const std::string &input, const std::string &output) const override {
+    signals_[output] = signal_of(input);
+  }
+
+  void on_gate(const std::vector<std::string> &inputs, const std::string &output,
+               const std::string &type) const override {
+    std::vector<signal> fs;
+    fs.reserve(inputs.size());
+    for (auto const &in : inputs) {
+      fs.push_back(signal_of(in));
+    }
+
+    std::string t = type;
+    std::transform(t.begin(), t.end(), t.begin(), ::toupper);
+
+    signal f;
+    if (t.size() > 2u && t[0] == '0' && t[1] == 'X') {
+      kitty::dynamic_truth_table tt(static_cast<uint32_t>(fs.size()));
+      kitty::create_from_hex_string(tt, type.substr(2u));
+      f = builder_.function(fs, tt);
+    } else if (t == "AND" || t == "NAND") {
+      f = ntk_.create_nary_and(fs);
+      f = t == "NAND" ? ntk_.create_not(f) : f;
+    } else if (t == "OR" || t == "NOR") {
+      f = ntk_.create_nary_or(fs);
+      f = t == "NOR" ? ntk_.create_not(f) : f;
+    } else if (t == "XOR" || t == "XNOR") {
+      f = ntk_.create_nary_xor(fs);
+      f = t == "XNOR" ? ntk_.create_not(f) : f;
+    } else if ((t == "NOT" || t == "BUF" || t == "BUFF") && fs.size() == 1u) {
+      f = t == "NOT" ? ntk_.create_not(fs[0]) : fs[0];
+    } else if (t == "VDD" || t == "ONE" || t == "GND" || t == "ZERO") {
+      f = ntk_.get_constant(t == "VDD" || t == "ONE");
+    } else {
+      std::cerr << "[w] unsupported bench gate " << type << "\n";
+      f = ntk_.get_constant(false);
+    }
+    signals_[output] = f;
+  }
+
+ private:
+  signal signal_of(std::string const &name) const {
+    if (auto it = signals_.find(name); it != signals_.end()) {
+      return it->second;
+    }
+    std::cerr << "[e] undefined signal " << name << "\n";
+    undefined_ = true;
+    return ntk_.get_constant(false);
+  }
+
+ private:
+  Ntk &ntk_;
+  mutable detail::logic_builder<Ntk> builder_;
+  mutable std::unordered_map<std::string, signal> signals_;
+  mutable std::vector<std::string> outputs_;
+  mutable bool undefined_ = false;
+};
+
+}  // namespace MagicLS
+
+#endif
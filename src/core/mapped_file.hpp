@@ -0,0 +1,73 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file mapped_file.hpp
+ *
+ * @brief  Read-only memory mapped files
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/10
+ */
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace MagicLS {
+
+/* Read-only memory mapping of a whole file. */
+class mapped_file {
+ public:
+  explicit mapped_file(std::string const &filename) {
+    fd_ = ::open(filename.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+      throw std::runtime_error("cannot open " + filename);
+    }
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) {
+      ::close(fd_);
+      throw std::runtime_error("cannot stat " + filename);
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ != 0u) {
+      void *p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+      if (p == MAP_FAILED) {
+        ::close(fd_);
+        throw std::runtime_error("cannot map " + filename);
+      }
+      data_ = static_cast<char const *>(p);
+      ::madvise(p, size_, MADV_SEQUENTIAL);
+    }
+  }
+
+  ~mapped_file() {
+    if (data_) {
+      ::munmap(const_cast<char *>(data_), size_);
+    }
+    ::close(fd_);
+  }
+
+  mapped_file(mapped_file const &) = delete;
+  mapped_file &operator=(mapped_file const &) = delete;
+
+  char const *data() const { return data_; }
+  std::size_t size() const { return size_; }
+
+ private:
+  int fd_ = -1;
+  char const *data_ = nullptr;
+  std::size_t size_ = 0u;
+};
+
+}  // namespace MagicLS
+
+#endif
@@ -0,0 +1,276 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file memo_cache.hpp
+ *
+ * @brief  Memoization of optimization commands on ABC networks and GIAs
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/24
+ */
+
+#ifndef MEMO_CACHE_HPP
+#define MEMO_CACHE_HPP
+
+#include <aig/gia/gia.h>
+#include <base/abc/abc.h>
+#include <base/io/ioAbc.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "./store_stats.hpp"
+
+namespace MagicLS {
+
+/*! \brief Switches shared by the memo caches of all network types.
+ *
+ * Memoization is off by default.  `capacity` bounds the number of entries
+ * kept in memory per network type; if `directory` is not empty results are
+ * also written there and read back on a miss in memory.
+ */
+struct memo_settings {
+  bool enabled = false;
+  std::size_t capacity = 256u;
+  std::string directory;
+
+  static memo_settings &instance() {
+    static memo_settings settings;
+    return settings;
+  }
+};
+
+/*! \brief Script with normalized whitespace, for use in memo keys.
+ *
+ * `;`-separated scripts are split into commands, runs of blanks collapse
+ * into one space, so "&st;  &dc2 " and "&st; &dc2" give the same key.
+ */
+inline std::string normalize_script(std::string const &script) {
+  std::string result;
+  std::istringstream commands(script);
+  std::string command;
+  while (std::getline(commands, command, ';')) {
+    std::istringstream words(command);
+    std::string word, normalized;
+    while (words >> word) {
+      normalized += (normalized.empty() ? "" : " ") + word;
+    }
+    if (!normalized.empty()) {
+      result += (result.empty() ? "" : "; ") + normalized;
+    }
+  }
+  return result;
+}
+
+template <class... Args>
+std::string memo_key(std::string const &command, Args const &...args) {
+  std::string key = command;
+  ((key += " " + fmt::format("{}", args)), ...);
+  return key;
+}
+
+namespace detail {
+
+template <class T>
+struct memo_traits;
+
+template <>
+struct memo_traits<pabc::Abc_Ntk_t *> {
+  static constexpr const char *extension = "aig";
+
+  static pabc::Abc_Ntk_t *copy(pabc::Abc_Ntk_t *ntk) { return pabc::Abc_NtkDup(ntk); }
+  static void release(pabc::Abc_Ntk_t *ntk) { pabc::Abc_NtkDelete(ntk); }
+
+  /* AIGER keeps neither choices nor mapped gates */
+  static bool persistent(pabc::Abc_Ntk_t *ntk) {
+    return pabc::Abc_NtkIsStrash(ntk) && pabc::Abc_NtkGetChoiceNum(ntk) == 0;
+  }
+  static void write(pabc::Abc_Ntk_t *ntk, std::string const &filename) {
+    pabc::Io_WriteAiger(ntk, const_cast<char *>(filename.c_str()), 1, 0, 0);
+  }
+  static pabc::Abc_Ntk_t *read(std::string const &filename) {
+    return pabc::Io_ReadAiger(const_cast<char *>(filename.c_str()), 1);
+  }
+};
+
+template <>
+struct memo_traits<pabc::Gia_Man_t *> {
+  static constexpr const char *extension = "gia.aig";
+
+  /* keeps LUT mappings, which `&if` scripts produce */
+  static pabc::Gia_Man_t *copy(pabc::Gia_Man_t *gia) {
+    return pabc::Gia_ManDupWithAttributes(gia);
+  }
+  static void release(pabc::Gia_Man_t *gia) { release_gia(gia); }
+
+  static bool persistent(pabc::Gia_Man_t *gia) { return !pabc::Gia_ManHasChoices(gia); }
+  static void write(pabc::Gia_Man_t *gia, std::string const &filename) {
+    pabc::Gia_AigerWrite(gia, const_cast<char *>(filename.c_str()), 0, 0, 0);
+  }
+  static pabc::Gia_Man_t *read(std::string const &filename) {
+    return pabc::Gia_AigerRead(const_cast<char *>(filename.c_str()), 0, 0, 0);
+  }
+};
+
+/* FNV-1a, stable across runs unlike std::hash */
+inline uint64_t string_hash(std::string const &s) {
+  uint64_t h = 0xcbf29ce484222325ull;
+  for (unsigned char c : s) {
+    h = (h ^ c) * 0x100000001b3ull;
+  }
+  return h;
+}
+
+}  // namespace detail
+
+/*! \brief LRU cache from (structural hash of the input, command key) to the
+ * resulting network.
+ *
+ * The cache owns copies of the networks it stores and hands out fresh
+ * copies, so callers keep the ownership rules of the stores.  All member
+ * functions are thread-safe.
+ */
+template <class T>
+class memo_cache {
+  using traits = detail::memo_traits<T>;
+
+  struct entry {
+    std::string key;
+    T network;
+  };
+
+ public:
+  static memo_cache &instance() {
+    static memo_cache cache;
+    return cache;
+  }
+
+  std::optional<T> lookup(uint64_t input_hash, std::string const &command) {
+    auto const &settings = memo_settings::instance();
+    if (!settings.enabled) {
+      return std::nullopt;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto key = make_key(input_hash, command);
+    if (auto it = index_.find(key); it != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, it->second);
+      ++hits_;
+      return traits::copy(it->second->network);
+    }
+
+    if (!settings.directory.empty()) {
+      const auto filename = file_of(settings.directory, input_hash, command);
+      std::error_code ec;
+      if (std::filesystem::exists(filename, ec)) {
+        if (T ntk = traits::read(filename)) {
+          ++hits_;
+          ++disk_hits_;
+          put(key, ntk);
+          return traits::copy(ntk);
+        }
+      }
+    }
+
+    ++misses_;
+    return std::nullopt;
+  }
+
+  /* stores a copy of `result` */
+  void insert(uint64_t input_hash, std::string const &command, T result) {
+    auto const &settings = memo_settings::instance();
+    if (!settings.enabled || result == nullptr) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto key = make_key(input_hash, command);
+    if (index_.count(key) != 0u) {
+      return;
+    }
+    T ntk = traits::copy(result);
+    put(key, ntk);
+
+    if (!settings.directory.empty() && traits::persistent(ntk)) {
+      std::error_code ec;
+      std::filesystem::create_directories(settings.directory, ec);
+      traits::write(ntk, file_of(settings.directory, input_hash, command));
+    }
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &e : entries_) {
+      traits::release(e.network);
+    }
+    entries_.clear();
+    index_.clear();
+    hits_ = misses_ = disk_hits_ = evictions_ = 0u;
+  }
+
+  /* drops the least recently used entries beyond the capacity */
+  void shrink() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    evict();
+  }
+
+  std::string report() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return fmt::format("entries = {}   hits = {} ({} from disk)   misses = {}   evictions = {}",
+                       entries_.size(), hits_, disk_hits_, misses_, evictions_);
+  }
+
+ private:
+  memo_cache() = default;
+
+  static std::string make_key(uint64_t input_hash, std::string const &command) {
+    return fmt::format("{:016x}|{}", input_hash, command);
+  }
+
+  static std::string file_of(std::string const &directory, uint64_t input_hash,
+                             std::string const &command) {
+    const auto name = fmt::format("{:016x}-{:016x}.{}", input_hash,
+                                  detail::string_hash(command), traits::extension);
+    return (std::filesystem::path(directory) / name).string();
+  }
+
+  void put(std::string const &key, T ntk) {
+    entries_.push_front({key, ntk});
+    index_[key] = entries_.begin();
+    evict();
+  }
+
+  void evict() {
+    const auto capacity = std::max<std::size_t>(memo_settings::instance().capacity, 1u);
+    while (entries_.size() > capacity) {
+      traits::release(entries_.back().network);
+      index_.erase(entries_.back().key);
+      entries_.pop_back();
+      ++evictions_;
+    }
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::list<entry> entries_;
+  std::unordered_map<std::string, typename std::list<entry>::iterator> index_;
+  uint64_t hits_ = 0u;
+  uint64_t misses_ = 0u;
+  uint64_t disk_hits_ = 0u;
+  uint64_t evictions_ = 0u;
+};
+
+}  // namespace MagicLS
+
+#endif
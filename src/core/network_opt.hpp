@@ -0,0 +1,130 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file network_opt.hpp
+ *
+ * @brief  Native mockturtle optimization passes on AIGs, MIGs, XAGs and XMGs
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/22
+ */
+
+#ifndef NETWORK_OPT_HPP
+#define NETWORK_OPT_HPP
+
+#include <type_traits>
+
+#include <mockturtle/algorithms/aig_resub.hpp>
+#include <mockturtle/algorithms/balancing.hpp>
+#include <mockturtle/algorithms/balancing/sop_balancing.hpp>
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/cut_rewriting.hpp>
+#include <mockturtle/algorithms/mig_algebraic_rewriting.hpp>
+#include <mockturtle/algorithms/mig_resub.hpp>
+#include <mockturtle/algorithms/node_resynthesis/mig_npn.hpp>
+#include <mockturtle/algorithms/node_resynthesis/sop_factoring.hpp>
+#include <mockturtle/algorithms/node_resynthesis/xag_npn.hpp>
+#include <mockturtle/algorithms/node_resynthesis/xmg_npn.hpp>
+#include <mockturtle/algorithms/refactoring.hpp>
+#include <mockturtle/algorithms/xag_resub.hpp>
+#include <mockturtle/algorithms/xmg_resub.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+#include <mockturtle/views/depth_view.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+
+namespace MagicLS {
+
+/*! \brief Exact 4-input NPN database used to rewrite cuts of `Ntk`. */
+template <class Ntk>
+struct npn_rewriting_of;
+
+template <>
+struct npn_rewriting_of<mockturtle::aig_network> {
+  using type =
+      mockturtle::xag_npn_resynthesis<mockturtle::aig_network, mockturtle::xag_network,
+                                      mockturtle::xag_npn_db_kind::aig_complete>;
+};
+
+template <>
+struct npn_rewriting_of<mockturtle::xag_network> {
+  using type = mockturtle::xag_npn_resynthesis<mockturtle::xag_network>;
+};
+
+template <>
+struct npn_rewriting_of<mockturtle::mig_network> {
+  using type = mockturtle::mig_npn_resynthesis;
+};
+
+template <>
+struct npn_rewriting_of<mockturtle::xmg_network> {
+  using type = mockturtle::xmg_npn_resynthesis;
+};
+
+/*
+ * The in-place passes work on a clone: store entries share their storage,
+ * so rewriting the current network directly would also change every copy
+ * of it kept in the store history.
+ */
+
+template <class Ntk>
+Ntk cut_rewrite(Ntk const &ntk, mockturtle::cut_rewriting_params const &ps,
+                mockturtle::cut_rewriting_stats *st = nullptr) {
+  typename npn_rewriting_of<Ntk>::type resyn;
+  Ntk res = ntk.clone();
+  mockturtle::cut_rewriting(res, resyn, ps, st);
+  return mockturtle::cleanup_dangling(res);
+}
+
+inline mockturtle::mig_network depth_rewrite(
+    mockturtle::mig_network const &mig,
+    mockturtle::mig_algebraic_depth_rewriting_params const &ps,
+    mockturtle::mig_algebraic_depth_rewriting_stats *st = nullptr) {
+  mockturtle::mig_network res = mig.clone();
+  mockturtle::depth_view<mockturtle::mig_network> depth{res};
+  mockturtle::mig_algebraic_depth_rewriting(depth, ps, st);
+  return mockturtle::cleanup_dangling(res);
+}
+
+template <class Ntk>
+Ntk resubstitute(Ntk const &ntk, mockturtle::resubstitution_params const &ps,
+                 mockturtle::resubstitution_stats *st = nullptr) {
+  Ntk res = ntk.clone();
+  mockturtle::fanout_view<Ntk> fanout{res};
+  mockturtle::depth_view<mockturtle::fanout_view<Ntk>> view{fanout};
+
+  if constexpr (std::is_same_v<Ntk, mockturtle::aig_network>) {
+    mockturtle::aig_resubstitution(view, ps, st);
+  } else if constexpr (std::is_same_v<Ntk, mockturtle::xag_network>) {
+    mockturtle::xag_resubstitution(view, ps, st);
+  } else if constexpr (std::is_same_v<Ntk, mockturtle::mig_network>) {
+    mockturtle::mig_resubstitution(view, ps, st);
+  } else {
+    mockturtle::xmg_resubstitution(view, ps, st);
+  }
+  return mockturtle::cleanup_dangling(res);
+}
+
+/* Rebuilds the cuts on the critical path (or everywhere) as balanced SOPs. */
+template <class Ntk>
+Ntk sop_balance(Ntk const &ntk, mockturtle::balancing_params const &ps,
+                mockturtle::balancing_stats *st = nullptr) {
+  mockturtle::sop_rebalancing<Ntk> rebalance;
+  return mockturtle::balancing(ntk, {rebalance}, ps, st);
+}
+
+template <class Ntk>
+Ntk refactor(Ntk const &ntk, mockturtle::refactoring_params const &ps,
+             mockturtle::refactoring_stats *st = nullptr) {
+  mockturtle::sop_factoring<Ntk> resyn;
+  Ntk res = ntk.clone();
+  mockturtle::refactoring(res, resyn, ps, st);
+  return mockturtle::cleanup_dangling(res);
+}
+
+}  // namespace MagicLS
+
+#endif
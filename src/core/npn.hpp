@@ -0,0 +1,212 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file npn.hpp
+ *
+ * @brief  Selectable NPN canonization and a deduplication index of functions
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/29
+ */
+
+#ifndef NPN_HPP
+#define NPN_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/hash.hpp>
+#include <kitty/npn.hpp>
+#include <kitty/static_truth_table.hpp>
+
+namespace MagicLS {
+
+using npn_result = std::tuple<kitty::dynamic_truth_table, uint32_t, std::vector<uint8_t>>;
+
+/* exact: the class representative, exponential in the number of variables;
+ * sifting and flip_swap: semi-canonical forms, the same class may give a
+ * few different representatives but the cost is polynomial */
+enum class npn_canonizer { exact, sifting, flip_swap };
+
+inline std::optional<npn_canonizer> npn_canonizer_from_string(std::string const &name) {
+  if (name == "exact" || name == "1") {
+    return npn_canonizer::exact;
+  }
+  if (name == "sifting" || name == "semi") {
+    return npn_canonizer::sifting;
+  }
+  if (name == "flip_swap") {
+    return npn_canonizer::flip_swap;
+  }
+  return std::nullopt;
+}
+
+namespace detail {
+
+/* Up to 6 variables a truth table is one machine word, on which kitty's
+ * static truth tables run the canonization without heap allocations. */
+template <uint32_t NumVars>
+npn_result exact_npn_word(kitty::dynamic_truth_table const &tt) {
+  kitty::static_truth_table<NumVars> word;
+  kitty::create_from_words(word, tt.cbegin(), tt.cend());
+  const auto [canon, phase, perm] = kitty::exact_npn_canonization(word);
+
+  kitty::dynamic_truth_table res(NumVars);
+  kitty::create_from_words(res, canon.cbegin(), canon.cend());
+  return {res, phase, perm};
+}
+
+}  // namespace detail
+
+/*! \brief `kitty::exact_npn_canonization` with single-word truth tables for
+ * up to 6 variables. */
+inline npn_result fast_exact_npn_canonization(kitty::dynamic_truth_table const &tt) {
+  switch (tt.num_vars()) {
+    case 1u:
+      return detail::exact_npn_word<1u>(tt);
+    case 2u:
+      return detail::exact_npn_word<2u>(tt);
+    case 3u:
+      return detail::exact_npn_word<3u>(tt);
+    case 4u:
+      return detail::exact_npn_word<4u>(tt);
+    case 5u:
+      return detail::exact_npn_word<5u>(tt);
+    case 6u:
+      return detail::exact_npn_word<6u>(tt);
+    default:
+      return kitty::exact_npn_canonization(tt);
+  }
+}
+
+/*! \brief Thread-safe memo of exact representatives of functions with more
+ * than 6 variables, where a canonization costs far more than a lookup.
+ *
+ * The memo is dropped when it exceeds `capacity` entries.
+ */
+class npn_memo {
+ public:
+  static npn_memo &instance() {
+    static npn_memo memo;
+    return memo;
+  }
+
+  kitty::dynamic_truth_table canonize(kitty::dynamic_truth_table const &tt) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (auto it = map_.find(tt); it != map_.end()) {
+        return it->second;
+      }
+    }
+    auto canon = std::get<0>(kitty::exact_npn_canonization(tt));
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (map_.size() >= capacity) {
+      map_.clear();
+    }
+    map_.emplace(tt, canon);
+    return canon;
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    map_.clear();
+  }
+
+ public:
+  std::size_t capacity = 1u << 20u;
+
+ private:
+  npn_memo() = default;
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<kitty::dynamic_truth_table, kitty::dynamic_truth_table,
+                     kitty::hash<kitty::dynamic_truth_table>>
+      map_;
+};
+
+/* The representative of `tt` under `method`; thread-safe. */
+inline kitty::dynamic_truth_table npn_canonize(kitty::dynamic_truth_table const &tt,
+                                               npn_canonizer method) {
+  switch (method) {
+    case npn_canonizer::sifting:
+      return std::get<0>(kitty::sifting_npn_canonization(tt));
+    case npn_canonizer::flip_swap:
+      return std::get<0>(kitty::flip_swap_npn_canonization(tt));
+    default:
+      if (tt.num_vars() <= 6u) {
+        return std::get<0>(fast_exact_npn_canonization(tt));
+      }
+      return npn_memo::instance().canonize(tt);
+  }
+}
+
+/*! \brief Clearable index of the functions seen so far, per number of
+ * variables.  All member functions are thread-safe.
+ */
+class function_index {
+  using set_t = std::unordered_set<kitty::dynamic_truth_table,
+                                   kitty::hash<kitty::dynamic_truth_table>>;
+
+ public:
+  static function_index &instance() {
+    static function_index index;
+    return index;
+  }
+
+  /* returns whether `tt` was new */
+  bool insert(kitty::dynamic_truth_table const &tt) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tt.num_vars() >= sets_.size()) {
+      sets_.resize(tt.num_vars() + 1u);
+    }
+    return sets_[tt.num_vars()].insert(tt).second;
+  }
+
+  bool contains(kitty::dynamic_truth_table const &tt) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tt.num_vars() < sets_.size() && sets_[tt.num_vars()].count(tt) != 0u;
+  }
+
+  void reserve(uint32_t num_vars, std::size_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (num_vars >= sets_.size()) {
+      sets_.resize(num_vars + 1u);
+    }
+    sets_[num_vars].reserve(count);
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sets_.clear();
+  }
+
+  std::size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t size = 0u;
+    for (auto const &s : sets_) {
+      size += s.size();
+    }
+    return size;
+  }
+
+ private:
+  function_index() = default;
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<set_t> sets_;
+};
+
+}  // namespace MagicLS
+
+#endif
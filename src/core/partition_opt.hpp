@@ -0,0 +1,239 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file partition_opt.hpp
+ *
+ * @brief  Window partitioning of AIGs for parallel optimization
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/23
+ */
+
+#ifndef PARTITION_OPT_HPP
+#define PARTITION_OPT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/networks/aig.hpp>
+
+#include "./thread_pool.hpp"
+
+namespace MagicLS {
+
+/*! \brief A window of an AIG.
+ *
+ * `gates` are in topological order, `leaves` are the nodes outside the
+ * window feeding it (primary inputs or gates of earlier windows), `roots`
+ * are the gates used outside the window.  The constant node is never a
+ * leaf.
+ */
+struct aig_window {
+  std::vector<mockturtle::aig_network::node> gates;
+  std::vector<mockturtle::aig_network::node> leaves;
+  std::vector<mockturtle::aig_network::node> roots;
+};
+
+/*! \brief Splits the gates reachable from the outputs into windows.
+ *
+ * The gates are collected in an iterative depth-first post-order from the
+ * outputs, which keeps the fanin cones of neighbouring outputs together,
+ * and cut into consecutive chunks of at most `max_gates` gates.  Every
+ * leaf of a window therefore lies in an earlier window or is an input.
+ */
+inline std::vector<aig_window> partition_windows(mockturtle::aig_network const &aig,
+                                                 uint32_t max_gates) {
+  using node = mockturtle::aig_network::node;
+  constexpr auto none = std::numeric_limits<uint32_t>::max();
+  max_gates = std::max(max_gates, 1u);
+
+  /* iterative post-order, deep AIGs would overflow a recursive one */
+  std::vector<uint32_t> window_of(aig.size(), none);
+  std::vector<aig_window> windows;
+  std::vector<bool> visited(aig.size(), false);
+  std::vector<std::pair<node, bool>> stack;
+
+  auto place = [&](node n) {
+    if (windows.empty() || windows.back().gates.size() >= max_gates) {
+      windows.emplace_back();
+    }
+    window_of[aig.node_to_index(n)] = static_cast<uint32_t>(windows.size() - 1u);
+    windows.back().gates.push_back(n);
+  };
+
+  aig.foreach_po([&](auto const &f) {
+    stack.emplace_back(aig.get_node(f), false);
+    while (!stack.empty()) {
+      auto [n, expanded] = stack.back();
+      stack.pop_back();
+      const auto index = aig.node_to_index(n);
+      if (expanded) {
+        place(n);
+        continue;
+      }
+      if (visited[index] || !aig.is_and(n)) {
+        continue;
+      }
+      visited[index] = true;
+      stack.emplace_back(n, true);
+      aig.foreach_fanin(n, [&](auto const &fi) {
+        if (!visited[aig.node_to_index(aig.get_node(fi))]) {
+          stack.emplace_back(aig.get_node(fi), false);
+        }
+      });
+    }
+  });
+
+  /* leaves and roots; a stamp per node avoids duplicate leaves */
+  std::vector<uint32_t> stamp(aig.size(), none);
+  std::vector<bool> is_root(aig.size(), false);
+  for (auto w = 0u; w < windows.size(); ++w) {
+    for (auto const &n : windows[w].gates) {
+      aig.foreach_fanin(n, [&](auto const &fi) {
+        const auto c = aig.get_node(fi);
+        const auto ci = aig.node_to_index(c);
+        if (aig.is_constant(c) || window_of[ci] == w) {
+          return;
+        }
+        if (window_of[ci] != none) {
+          is_root[ci] = true;
+        }
+        if (stamp[ci] != w) {
+          stamp[ci] = w;
+          windows[w].leaves.push_back(c);
+        }
+      });
+    }
+  }
+  aig.foreach_po([&](auto const &f) { is_root[aig.node_to_index(aig.get_node(f))] = true; });
+  for (auto &win : windows) {
+    for (auto const &n : win.gates) {
+      if (is_root[aig.node_to_index(n)]) {
+        win.roots.push_back(n);
+      }
+    }
+  }
+
+  return windows;
+}
+
+/* The window as an AIG with one input per leaf and one output per root. */
+inline mockturtle::aig_network extract_window(mockturtle::aig_network const &aig,
+                                              aig_window const &win) {
+  using signal = mockturtle::aig_network::signal;
+
+  mockturtle::aig_network sub;
+  std::unordered_map<uint64_t, signal> old2new;
+  old2new.reserve(win.leaves.size() + win.gates.size());
+  for (auto const &l : win.leaves) {
+    old2new[aig.node_to_index(l)] = sub.create_pi();
+  }
+
+  auto translate = [&](signal const &f) {
+    const auto n = aig.get_node(f);
+    const auto s = aig.is_constant(n) ? sub.get_constant(false) : old2new.at(aig.node_to_index(n));
+    return aig.is_complemented(f) ? sub.create_not(s) : s;
+  };
+
+  for (auto const &n : win.gates) {
+    std::array<signal, 2> fs;
+    aig.foreach_fanin(n, [&](auto const &fi, auto i) { fs[i] = translate(fi); });
+    old2new[aig.node_to_index(n)] = sub.create_and(fs[0], fs[1]);
+  }
+  for (auto const &r : win.roots) {
+    sub.create_po(old2new.at(aig.node_to_index(r)));
+  }
+  return sub;
+}
+
+struct partition_opt_stats {
+  uint32_t windows = 0u;
+  uint32_t improved = 0u;
+  uint32_t failed = 0u;
+};
+
+/*! \brief Optimizes the windows of `aig` on a thread pool and stitches them.
+ *
+ * `optimize` gets an extracted window and returns an AIG with the same
+ * inputs and outputs.  A window is replaced only if the result has fewer
+ * gates and the same interface; otherwise, and if `optimize` throws, the
+ * original gates are kept.  The outputs of every window are rebuilt from
+ * the stitched signals of its leaves, so the interface between windows is
+ * preserved.
+ */
+inline mockturtle::aig_network partition_optimize(
+    mockturtle::aig_network const &aig, uint32_t max_gates, thread_pool &pool,
+    std::function<mockturtle::aig_network(mockturtle::aig_network const &)> const &optimize,
+    partition_opt_stats *pst = nullptr) {
+  using signal = mockturtle::aig_network::signal;
+
+  const auto windows = partition_windows(aig, max_gates);
+
+  /* each task extracts its window, so extraction runs in parallel too */
+  enum class outcome { kept, improved, failed };
+  std::vector<std::future<std::pair<mockturtle::aig_network, outcome>>> results;
+  results.reserve(windows.size());
+  for (auto const &win : windows) {
+    results.push_back(pool.submit([&aig, &win, &optimize]() {
+      auto sub = extract_window(aig, win);
+      try {
+        auto opt = optimize(sub);
+        if (opt.num_pis() == sub.num_pis() && opt.num_pos() == sub.num_pos() &&
+            opt.num_gates() < sub.num_gates()) {
+          return std::make_pair(std::move(opt), outcome::improved);
+        }
+      } catch (...) {
+        return std::make_pair(std::move(sub), outcome::failed);
+      }
+      return std::make_pair(std::move(sub), outcome::kept);
+    }));
+  }
+
+  partition_opt_stats st;
+  st.windows = static_cast<uint32_t>(windows.size());
+
+  mockturtle::aig_network res;
+  std::vector<signal> old2new(aig.size());
+  old2new[aig.node_to_index(aig.get_node(aig.get_constant(false)))] = res.get_constant(false);
+  aig.foreach_pi([&](auto const &n) { old2new[aig.node_to_index(n)] = res.create_pi(); });
+
+  /* windows only depend on earlier ones, so they are stitched in order */
+  for (auto w = 0u; w < windows.size(); ++w) {
+    auto [sub, result] = results[w].get();
+    st.improved += result == outcome::improved ? 1u : 0u;
+    st.failed += result == outcome::failed ? 1u : 0u;
+
+    std::vector<signal> leaves;
+    leaves.reserve(windows[w].leaves.size());
+    for (auto const &l : windows[w].leaves) {
+      leaves.push_back(old2new[aig.node_to_index(l)]);
+    }
+    const auto outputs = mockturtle::cleanup_dangling(sub, res, leaves.begin(), leaves.end());
+    for (auto i = 0u; i < outputs.size(); ++i) {
+      old2new[aig.node_to_index(windows[w].roots[i])] = outputs[i];
+    }
+  }
+
+  aig.foreach_po([&](auto const &f) {
+    const auto s = old2new[aig.node_to_index(aig.get_node(f))];
+    res.create_po(aig.is_complemented(f) ? res.create_not(s) : s);
+  });
+
+  if (pst) {
+    *pst = st;
+  }
+  return res;
+}
+
+}  // namespace MagicLS
+
+#endif
@@ -0,0 +1,92 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file recovery_variants.hpp
+ *
+ * @brief  Mapping with several area recovery settings, keeping the best
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/18
+ */
+
+#ifndef RECOVERY_VARIANTS_HPP
+#define RECOVERY_VARIANTS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <future>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "./thread_pool.hpp"
+
+namespace MagicLS {
+
+struct recovery_rounds {
+  uint32_t area_flow = 0u;
+  uint32_t exact_area = 0u;
+};
+
+/*! \brief Maps with up to eight recovery settings and returns the best result.
+ *
+ * mockturtle's mappers enumerate the cuts of one mapping on a single
+ * thread, so this is the only parallelism: `map_one(rounds, alone)` is run
+ * on a pool of `num_variants` threads, once per setting, each adding extra
+ * area flow and exact area rounds to `base`.  `alone` tells `map_one` that
+ * it is the only run, which may then work on the network itself and print
+ * verbose output.  `better(a, b)` orders the results.
+ */
+template <class MapFn, class Better>
+std::invoke_result_t<MapFn, recovery_rounds, bool> map_best_recovery(recovery_rounds const &base,
+                                                                     uint32_t num_variants,
+                                                                     MapFn &&map_one,
+                                                                     Better &&better) {
+  using result_t = std::invoke_result_t<MapFn, recovery_rounds, bool>;
+
+  /* extra area flow and exact area rounds of each setting */
+  static constexpr recovery_rounds variants[] = {{0u, 0u}, {0u, 1u}, {1u, 0u}, {1u, 1u},
+                                                 {2u, 2u}, {0u, 2u}, {2u, 0u}, {3u, 3u}};
+  const auto count =
+      std::clamp<uint32_t>(num_variants, 1u, static_cast<uint32_t>(std::size(variants)));
+  auto rounds_of = [&](uint32_t i) {
+    return recovery_rounds{base.area_flow + variants[i].area_flow,
+                           base.exact_area + variants[i].exact_area};
+  };
+
+  if (count == 1u) {
+    return map_one(rounds_of(0u), true);
+  }
+
+  std::vector<std::future<result_t>> futures;
+  {
+    thread_pool pool(count);
+    for (auto i = 0u; i < count; ++i) {
+      futures.push_back(pool.submit([&map_one, rounds = rounds_of(i)]() { return map_one(rounds, false); }));
+    }
+  }
+
+  std::vector<result_t> results;
+  results.reserve(count);
+  for (auto &f : futures) {
+    results.push_back(f.get());
+  }
+  auto best = 0u;
+  for (auto i = 1u; i < count; ++i) {
+    if (better(results[i], results[best])) {
+      best = i;
+    }
+  }
+  std::cout << fmt::format("[i] best of {} recovery settings: area flow {}, exact area {}\n",
+                           count, rounds_of(best).area_flow, rounds_of(best).exact_area);
+  return std::move(results[best]);
+}
+
+}  // namespace MagicLS
+
+#endif
@@ -0,0 +1,471 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file session.hpp
+ *
+ * @brief  Binary session snapshots of the stores
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/10
+ */
+
+#ifndef SESSION_HPP
+#define SESSION_HPP
+
+#include <aig/gia/gia.h>
+#include <base/abc/abc.h>
+#include <base/io/ioAbc.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operations.hpp>
+#include <mockturtle/io/genlib_reader.hpp>
+#include <mockturtle/networks/klut.hpp>
+
+#include "./abc_api.hpp"
+#include "./mapped_file.hpp"
+#include "./store_stats.hpp"
+
+namespace MagicLS {
+
+/* File layout (native endianness, all blocks 8-byte aligned):
+ *
+ *   "MLSS" u32 version u32 #sections
+ *   section: u32 tag u32 #entries, entry: u64 #bytes, payload
+ *
+ * mockturtle AIG/MIG/XAG/XMG payloads hold the raw node, input and output
+ * arrays of the network storage, so restoring an entry is a bulk copy out of
+ * the memory-mapped file plus rebuilding the structural hash table.  GIAs
+ * and strashed ABC networks are stored as binary AIGER, other ABC networks
+ * as BLIF text. */
+constexpr uint32_t session_version = 1u;
+
+enum class session_tag : uint32_t {
+  aig = 1,
+  mig,
+  xag,
+  xmg,
+  klut,
+  abc,
+  gia,
+  genlib,
+  opt
+};
+
+class session_writer {
+ public:
+  explicit session_writer(std::string const &filename)
+      : os_(filename, std::ios::binary | std::ios::trunc) {
+    if (!os_) {
+      throw std::runtime_error("cannot open " + filename);
+    }
+    os_.write("MLSS", 4);
+    put<uint32_t>(session_version);
+    sections_pos_ = os_.tellp();
+    put<uint32_t>(0u);
+    pad();
+  }
+
+  /* best effort if `finish` was not called, e.g. after an exception */
+  ~session_writer() {
+    if (!finished_) {
+      finish();
+    }
+  }
+
+  void begin_section(session_tag tag, uint32_t num_entries) {
+    put<uint32_t>(static_cast<uint32_t>(tag));
+    put<uint32_t>(num_entries);
+    ++num_sections_;
+  }
+
+  /* an entry is written as its size followed by the aligned payload */
+  void entry(std::string const &payload) {
+    put<uint64_t>(payload.size());
+    os_.write(payload.data(), payload.size());
+    pad();
+  }
+
+  /* patches the section count and closes the file, returns whether every
+   * write succeeded */
+  bool finish() {
+    finished_ = true;
+    os_.seekp(sections_pos_);
+    put<uint32_t>(num_sections_);
+    os_.flush();
+    os_.close();
+    return !os_.fail();
+  }
+
+ private:
+  template <typename T>
+  void put(T const &value) {
+    os_.write(reinterpret_cast<char const *>(&value), sizeof(T));
+  }
+
+  void pad() {
+    static const char zeros[8] = {};
+    const auto rem = static_cast<uint64_t>(os_.tellp()) % 8u;
+    if (rem != 0u) {
+      os_.write(zeros, 8u - rem);
+    }
+  }
+
+ private:
+  std::ofstream os_;
+  std::streampos sections_pos_;
+  uint32_t num_sections_ = 0u;
+  bool finished_ = false;
+};
+
+/* Builds an entry payload, keeping every array 8-byte aligned. */
+class payload_writer {
+ public:
+  template <typename T>
+  void put(T const &value) {
+    bytes(&value, sizeof(T));
+  }
+
+  void put(std::string const &s) {
+    put<uint64_t>(s.size());
+    bytes(s.data(), s.size());
+  }
+
+  void put(kitty::dynamic_truth_table const &tt) {
+    put<uint32_t>(tt.num_vars());
+    for (auto it = tt.cbegin(); it != tt.cend(); ++it) {
+      put<uint64_t>(*it);
+    }
+  }
+
+  void bytes(void const *data, std::size_t size) {
+    buffer_.append(static_cast<char const *>(data), size);
+  }
+
+  void align() { buffer_.append((8u - buffer_.size() % 8u) % 8u, '\0'); }
+
+  std::string const &str() const { return buffer_; }
+
+ private:
+  std::string buffer_;
+};
+
+/* Cursor over a memory-mapped region. */
+class payload_reader {
+ public:
+  payload_reader(char const *begin, std::size_t size)
+      : begin_(begin), pos_(begin), end_(begin + size) {}
+
+  template <typename T>
+  T get() {
+    T value;
+    std::memcpy(&value, take(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  std::string get_string() {
+    const auto size = get<uint64_t>();
+    return std::string(take(size), size);
+  }
+
+  kitty::dynamic_truth_table get_tt() {
+    kitty::dynamic_truth_table tt(get<uint32_t>());
+    for (auto it = tt.begin(); it != tt.end(); ++it) {
+      *it = get<uint64_t>();
+    }
+    return tt;
+  }
+
+  char const *take(std::size_t size) {
+    if (static_cast<std::size_t>(end_ - pos_) < size) {
+      throw std::runtime_error("truncated session file");
+    }
+    const auto *p = pos_;
+    pos_ += size;
+    return p;
+  }
+
+  void align() { pos_ = begin_ + ((pos_ - begin_ + 7) & ~std::ptrdiff_t(7)); }
+
+  std::size_t remaining() const { return static_cast<std::size_t>(end_ - pos_); }
+
+ private:
+  char const *begin_;
+  char const *pos_;
+  char const *end_;
+};
+
+/*! \brief Serializes an AIG/MIG/XAG/XMG by its raw storage arrays. */
+template <class Ntk>
+std::string save_network(Ntk const &ntk) {
+  using node_type = typename std::decay_t<decltype(ntk._storage->nodes)>::value_type;
+  using output_type = typename std::decay_t<decltype(ntk._storage->outputs)>::value_type;
+  auto const &st = *ntk._storage;
+
+  payload_writer w;
+  w.put<uint32_t>(sizeof(node_type));
+  w.put<uint32_t>(sizeof(output_type));
+  w.put<uint64_t>(st.nodes.size());
+  w.put<uint64_t>(st.inputs.size());
+  w.put<uint64_t>(st.outputs.size());
+  w.align();
+  w.bytes(st.nodes.data(), st.nodes.size() * sizeof(node_type));
+  w.align();
+  w.bytes(st.inputs.data(), st.inputs.size() * sizeof(uint64_t));
+  w.align();
+  w.bytes(st.outputs.data(), st.outputs.size() * sizeof(output_type));
+  return w.str();
+}
+
+template <class Ntk>
+Ntk load_network(payload_reader &r) {
+  Ntk ntk;
+  auto &st = *ntk._storage;
+  using node_type = typename std::decay_t<decltype(st.nodes)>::value_type;
+  using output_type = typename std::decay_t<decltype(st.outputs)>::value_type;
+
+  if (r.get<uint32_t>() != sizeof(node_type) ||
+      r.get<uint32_t>() != sizeof(output_type)) {
+    throw std::runtime_error("session was written by an incompatible build");
+  }
+  const auto num_nodes = r.get<uint64_t>();
+  const auto num_inputs = r.get<uint64_t>();
+  const auto num_outputs = r.get<uint64_t>();
+
+  /* the node arrays are plain data, copy them in bulk */
+  if (num_nodes == 0u || num_nodes > r.remaining() / sizeof(node_type) ||
+      num_inputs > r.remaining() / sizeof(uint64_t) ||
+      num_outputs > r.remaining() / sizeof(output_type)) {
+    throw std::runtime_error("truncated session file");
+  }
+  r.align();
+  const auto *nodes = r.take(num_nodes * sizeof(node_type));
+  st.nodes.resize(num_nodes);
+  std::memcpy(static_cast<void *>(st.nodes.data()), nodes, num_nodes * sizeof(node_type));
+  r.align();
+  const auto *inputs = r.take(num_inputs * sizeof(uint64_t));
+  st.inputs.resize(num_inputs);
+  std::memcpy(st.inputs.data(), inputs, num_inputs * sizeof(uint64_t));
+  r.align();
+  const auto *outputs = r.take(num_outputs * sizeof(output_type));
+  st.outputs.resize(num_outputs);
+  std::memcpy(static_cast<void *>(st.outputs.data()), outputs,
+              num_outputs * sizeof(output_type));
+
+  /* a damaged file must not make the traversals below read out of bounds */
+  auto check = [&](bool valid) {
+    if (!valid) {
+      throw std::runtime_error("corrupt network in session file");
+    }
+  };
+  std::vector<bool> is_input(num_nodes, false);
+  for (auto const &index : st.inputs) {
+    check(index != 0u && index < num_nodes);
+    is_input[index] = true;
+  }
+  for (auto i = 1u; i < num_nodes; ++i) {
+    if (!is_input[i]) {
+      for (auto const &child : st.nodes[i].children) {
+        check(child.index < num_nodes);
+      }
+    }
+  }
+  for (auto const &output : st.outputs) {
+    check(output.index < num_nodes);
+  }
+
+  /* rebuild the structural hash table */
+  st.hash.clear();
+  st.hash.reserve(num_nodes);
+  ntk.foreach_gate([&](auto const &n) {
+    st.hash.emplace(st.nodes[ntk.node_to_index(n)], ntk.node_to_index(n));
+  });
+
+  return ntk;
+}
+
+/*! \brief Serializes a k-LUT network node by node (fanins and function). */
+inline std::string save_network(mockturtle::klut_network const &klut) {
+  payload_writer w;
+  w.put<uint32_t>(klut.num_pis());
+  klut.foreach_pi([&](auto const &n) { w.put<uint64_t>(klut.node_to_index(n)); });
+  w.put<uint32_t>(klut.num_gates());
+  klut.foreach_gate([&](auto const &n) {
+    w.put<uint64_t>(klut.node_to_index(n));
+    w.put<uint32_t>(klut.fanin_size(n));
+    klut.foreach_fanin(n, [&](auto const &f) {
+      w.put<uint64_t>(klut.node_to_index(klut.get_node(f)));
+    });
+    w.put(klut.node_function(n));
+  });
+  w.put<uint32_t>(klut.num_pos());
+  klut.foreach_po([&](auto const &f) {
+    w.put<uint64_t>(klut.node_to_index(klut.get_node(f)));
+  });
+  return w.str();
+}
+
+template <>
+inline mockturtle::klut_network load_network<mockturtle::klut_network>(
+    payload_reader &r) {
+  using namespace mockturtle;
+  klut_network klut;
+  std::unordered_map<uint64_t, klut_network::signal> old2new{
+      {0u, klut.get_constant(false)}, {1u, klut.get_constant(true)}};
+
+  const auto num_pis = r.get<uint32_t>();
+  for (auto i = 0u; i < num_pis; ++i) {
+    old2new[r.get<uint64_t>()] = klut.create_pi();
+  }
+  const auto num_gates = r.get<uint32_t>();
+  for (auto i = 0u; i < num_gates; ++i) {
+    const auto index = r.get<uint64_t>();
+    std::vector<klut_network::signal> children(r.get<uint32_t>());
+    for (auto &c : children) {
+      c = old2new.at(r.get<uint64_t>());
+    }
+    old2new[index] = klut.create_node(children, r.get_tt());
+  }
+  const auto num_pos = r.get<uint32_t>();
+  for (auto i = 0u; i < num_pos; ++i) {
+    klut.create_po(old2new.at(r.get<uint64_t>()));
+  }
+  return klut;
+}
+
+/*! \brief GIAs are stored as binary AIGER produced in memory. */
+inline std::string save_network(pabc::Gia_Man_t *gia) {
+  pabc::Vec_Str_t *vStr = pabc::Gia_AigerWriteIntoMemoryStr(gia);
+  std::string payload(pabc::Vec_StrArray(vStr), pabc::Vec_StrSize(vStr));
+  pabc::Vec_StrFree(vStr);
+  return payload;
+}
+
+inline pabc::Gia_Man_t *load_gia(std::string payload) {
+  pabc::Gia_Man_t *gia = pabc::Gia_AigerReadFromMemory(
+      payload.data(), static_cast<int>(payload.size()), 0, 0, 0);
+  if (gia == nullptr) {
+    throw std::runtime_error("corrupt GIA in session file");
+  }
+  return gia;
+}
+
+/*! \brief Strashed ABC networks go through GIA, the others through BLIF. */
+inline std::string save_network(pabc::Abc_Ntk_t *pNtk) {
+  payload_writer w;
+  if (pabc::Abc_NtkIsStrash(pNtk)) {
+    pabc::Aig_Man_t *pAig = pabc::Abc_NtkToDar(pNtk, 0, 0);
+    pabc::Gia_Man_t *gia = pabc::Gia_ManFromAig(pAig);
+    pabc::Aig_ManStop(pAig);
+    w.put<uint32_t>(0u);
+    w.put(save_network(gia));
+    release_gia(gia);
+  } else {
+    const auto tmp = std::filesystem::temp_directory_path() /
+                     fmt::format("magicls_session_{}.blif", ::getpid());
+    pabc::Io_Write(pNtk, const_cast<char *>(tmp.c_str()), pabc::IO_FILE_BLIF);
+    std::ifstream in(tmp, std::ios::binary);
+    w.put<uint32_t>(1u);
+    w.put(std::string(std::istreambuf_iterator<char>(in), {}));
+    std::filesystem::remove(tmp);
+  }
+  return w.str();
+}
+
+inline pabc::Abc_Ntk_t *load_abc(payload_reader &r) {
+  const auto kind = r.get<uint32_t>();
+  const auto text = r.get_string();
+  if (kind == 0u) {
+    pabc::Gia_Man_t *gia = load_gia(text);
+    pabc::Aig_Man_t *pAig = pabc::Gia_ManToAig(gia, 0);
+    release_gia(gia);
+    if (pAig == nullptr) {
+      throw std::runtime_error("corrupt ABC network in session file");
+    }
+    pabc::Abc_Ntk_t *pNtk = pabc::Abc_NtkFromAigPhase(pAig);
+    pabc::Aig_ManStop(pAig);
+    if (pNtk == nullptr) {
+      throw std::runtime_error("corrupt ABC network in session file");
+    }
+    return pNtk;
+  }
+
+  const auto tmp = std::filesystem::temp_directory_path() /
+                   fmt::format("magicls_session_{}.blif", ::getpid());
+  std::ofstream(tmp, std::ios::binary) << text;
+  pabc::Abc_Ntk_t *pNtk =
+      pabc::Io_Read(const_cast<char *>(tmp.c_str()), pabc::IO_FILE_BLIF, 1, 0);
+  std::filesystem::remove(tmp);
+  if (pNtk == nullptr) {
+    throw std::runtime_error("corrupt ABC network in session file");
+  }
+  return pNtk;
+}
+
+/*! \brief GENLIB gates with their pins. */
+inline std::string save_library(std::vector<mockturtle::gate> const &gates) {
+  payload_writer w;
+  w.put<uint32_t>(gates.size());
+  for (auto const &g : gates) {
+    w.put<uint32_t>(g.id);
+    w.put(g.name);
+    w.put(g.expression);
+    w.put<uint32_t>(g.num_vars);
+    w.put(g.function);
+    w.put<double>(g.area);
+    w.put<uint32_t>(g.pins.size());
+    for (auto const &p : g.pins) {
+      w.put(p.name);
+      w.put<uint32_t>(static_cast<uint32_t>(p.phase));
+      w.put<double>(p.input_load);
+      w.put<double>(p.max_load);
+      w.put<double>(p.rise_block_delay);
+      w.put<double>(p.rise_fanout_delay);
+      w.put<double>(p.fall_block_delay);
+      w.put<double>(p.fall_fanout_delay);
+    }
+  }
+  return w.str();
+}
+
+inline std::vector<mockturtle::gate> load_library(payload_reader &r) {
+  std::vector<mockturtle::gate> gates(r.get<uint32_t>());
+  for (auto &g : gates) {
+    g.id = r.get<uint32_t>();
+    g.name = r.get_string();
+    g.expression = r.get_string();
+    g.num_vars = r.get<uint32_t>();
+    g.function = r.get_tt();
+    g.area = r.get<double>();
+    g.pins.resize(r.get<uint32_t>());
+    for (auto &p : g.pins) {
+      p.name = r.get_string();
+      p.phase = static_cast<decltype(p.phase)>(r.get<uint32_t>());
+      p.input_load = r.get<double>();
+      p.max_load = r.get<double>();
+      p.rise_block_delay = r.get<double>();
+      p.rise_fanout_delay = r.get<double>();
+      p.fall_block_delay = r.get<double>();
+      p.fall_fanout_delay = r.get<double>();
+    }
+  }
+  return gates;
+}
+
+}  // namespace MagicLS
+
+#endif
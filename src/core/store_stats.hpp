@@ -0,0 +1,264 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file store_stats.hpp
+ *
+ * @brief  Cached statistics of store entries
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/05
+ */
+
+#ifndef STORE_STATS_HPP
+#define STORE_STATS_HPP
+
+#include <aig/gia/gia.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+#include <mockturtle/networks/events.hpp>
+#include <mockturtle/traits.hpp>
+
+namespace MagicLS {
+
+struct network_stats {
+  uint32_t pis = 0u;
+  uint32_t pos = 0u;
+  uint32_t gates = 0u;
+  uint32_t levels = 0u;
+  /* gates not reachable from any output */
+  uint32_t dangling = 0u;
+  /* number of gates with fanout 0, 1, ..., the last bucket collects the rest */
+  std::vector<uint32_t> fanout_histogram;
+};
+
+inline std::string to_string(std::vector<uint32_t> const &histogram) {
+  std::string s;
+  for (auto i = 0u; i < histogram.size(); ++i) {
+    s += fmt::format("{}{}{}:{}", i == 0u ? "" : " ", i,
+                     i + 1u == histogram.size() ? "+" : "", histogram[i]);
+  }
+  return s;
+}
+
+/*! \brief Computes all statistics in one topological and one reverse pass.
+ *
+ * Dangling gates do not change the depth of the outputs, so no cleanup
+ * copy of the network is needed.
+ */
+template <class Ntk>
+network_stats compute_stats(Ntk const &ntk, uint32_t max_fanout_bucket = 8u) {
+  network_stats st;
+  st.pis = ntk.num_pis();
+  st.pos = ntk.num_pos();
+  st.gates = ntk.num_gates();
+  st.fanout_histogram.assign(max_fanout_bucket + 1u, 0u);
+
+  std::vector<uint32_t> level(ntk.size(), 0u);
+  std::vector<bool> live(ntk.size(), false);
+  std::vector<typename Ntk::node> gates;
+  gates.reserve(ntk.num_gates());
+
+  ntk.foreach_gate([&](auto const &n) {
+    uint32_t l = 0u;
+    ntk.foreach_fanin(n, [&](auto const &f) {
+      l = std::max(l, level[ntk.node_to_index(ntk.get_node(f))]);
+    });
+    level[ntk.node_to_index(n)] = l + 1u;
+    gates.push_back(n);
+
+    const auto fanout = std::min<uint32_t>(ntk.fanout_size(n), max_fanout_bucket);
+    ++st.fanout_histogram[fanout];
+  });
+
+  ntk.foreach_po([&](auto const &f) {
+    const auto index = ntk.node_to_index(ntk.get_node(f));
+    st.levels = std::max(st.levels, level[index]);
+    live[index] = true;
+  });
+
+  for (auto it = gates.rbegin(); it != gates.rend(); ++it) {
+    if (!live[ntk.node_to_index(*it)]) {
+      ++st.dangling;
+      continue;
+    }
+    ntk.foreach_fanin(*it, [&](auto const &f) {
+      live[ntk.node_to_index(ntk.get_node(f))] = true;
+    });
+  }
+
+  return st;
+}
+
+/*! \brief Statistics of mockturtle networks cached per storage.
+ *
+ * Store entries are keyed by their shared storage, so copies of a network
+ * share one record.  A record is recomputed only if the network changed:
+ * appended nodes or outputs change the size counters and in-place
+ * rewriting (`substitute_node`, ...) is caught by the network events.  The
+ * event callbacks of a record are released together with the record.
+ */
+template <class Ntk>
+class stats_cache {
+  using storage_t = typename Ntk::storage::element_type;
+  using events_t = mockturtle::network_events<typename Ntk::base_type>;
+
+  struct entry {
+    std::weak_ptr<storage_t> storage;
+    std::weak_ptr<events_t> events;
+    std::array<uint64_t, 3> fingerprint{};
+    std::shared_ptr<bool> modified;
+    std::shared_ptr<typename events_t::modified_event_type> on_modified;
+    std::shared_ptr<typename events_t::delete_event_type> on_delete;
+    network_stats stats;
+  };
+
+ public:
+  static stats_cache &instance() {
+    static stats_cache cache;
+    return cache;
+  }
+
+  network_stats const &get(Ntk const &ntk) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto key = static_cast<void const *>(ntk._storage.get());
+    const std::array<uint64_t, 3> fingerprint{ntk.size(), ntk.num_pos(),
+                                              ntk.num_gates()};
+
+    auto it = entries_.find(key);
+    if (it != entries_.end() && it->second.storage.lock() == ntk._storage &&
+        it->second.fingerprint == fingerprint && !*it->second.modified) {
+      return it->second.stats;
+    }
+
+    if (it != entries_.end()) {
+      release(it->second);
+      entries_.erase(it);
+    }
+    prune();
+
+    entry e;
+    e.storage = ntk._storage;
+    e.events = ntk._events;
+    e.fingerprint = fingerprint;
+    e.modified = std::make_shared<bool>(false);
+    auto modified = e.modified;
+    e.on_modified = ntk.events().register_modified_event(
+        [modified](auto const &, auto const &) { *modified = true; });
+    e.on_delete = ntk.events().register_delete_event(
+        [modified](auto const &) { *modified = true; });
+    e.stats = compute_stats(ntk);
+
+    return (entries_[key] = std::move(e)).stats;
+  }
+
+ private:
+  /* drops the records of networks that are no longer stored anywhere */
+  void prune() {
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (it->second.storage.expired()) {
+        release(it->second);
+        it = entries_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  static void release(entry &e) {
+    if (auto events = e.events.lock()) {
+      events->release_modified_event(e.on_modified);
+      events->release_delete_event(e.on_delete);
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<void const *, entry> entries_;
+};
+
+template <class Ntk>
+network_stats const &cached_stats(Ntk const &ntk) {
+  return stats_cache<Ntk>::instance().get(ntk);
+}
+
+/*! \brief Level counts of GIAs cached per manager.
+ *
+ * A record is validated by the size counters of the manager and must be
+ * dropped with `forget` before the manager is stopped, otherwise a new
+ * manager at the same address could be served its level, so every GIA
+ * that may have been measured is stopped through `release_gia`.  Store
+ * entries are never owned by the ABC frame, whose own rotation of GIAs
+ * thus never frees a measured manager.  The cache is cleared when it
+ * exceeds `capacity` records.
+ */
+class gia_levels_cache {
+  struct entry {
+    std::array<int, 3> fingerprint;
+    int levels;
+  };
+
+ public:
+  static gia_levels_cache &instance() {
+    static gia_levels_cache cache;
+    return cache;
+  }
+
+  int get(pabc::Gia_Man_t *gia) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const std::array<int, 3> fingerprint{pabc::Gia_ManObjNum(gia),
+                                         pabc::Gia_ManAndNum(gia),
+                                         pabc::Gia_ManPoNum(gia)};
+    auto it = entries_.find(gia);
+    if (it != entries_.end() && it->second.fingerprint == fingerprint) {
+      return it->second.levels;
+    }
+
+    if (entries_.size() >= capacity) {
+      entries_.clear();
+    }
+    const auto levels = pabc::Gia_ManLevelNum(gia);
+    entries_[gia] = {fingerprint, levels};
+    return levels;
+  }
+
+  void forget(pabc::Gia_Man_t const *gia) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.erase(gia);
+  }
+
+ public:
+  std::size_t capacity = 1024u;
+
+ private:
+  gia_levels_cache() = default;
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<pabc::Gia_Man_t const *, entry> entries_;
+};
+
+inline int cached_gia_levels(pabc::Gia_Man_t *gia) {
+  return gia_levels_cache::instance().get(gia);
+}
+
+/* Stops a GIA that may have a cached level count */
+inline void release_gia(pabc::Gia_Man_t *gia) {
+  gia_levels_cache::instance().forget(gia);
+  pabc::Gia_ManStop(gia);
+}
+
+}  // namespace MagicLS
+
+#endif
@@ -0,0 +1,274 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file struct_hash.hpp
+ *
+ * @brief  Structural hashes of AIG, GIA and ABC networks
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/08
+ */
+
+#ifndef STRUCT_HASH_HPP
+#define STRUCT_HASH_HPP
+
+#include <aig/gia/gia.h>
+#include <base/abc/abc.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+
+namespace MagicLS {
+
+namespace detail {
+
+inline uint64_t mix(uint64_t x) {
+  /* splitmix64 finalizer */
+  x += 0x9e3779b97f4a7c15ull;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+inline uint64_t combine(uint64_t seed, uint64_t value) {
+  return mix(seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2)));
+}
+
+/* hash of a (possibly complemented) edge */
+inline uint64_t edge(uint64_t node_hash, bool complemented) {
+  return complemented ? mix(node_hash ^ 0x5bd1e9955bd1e995ull) : node_hash;
+}
+
+/* hash of an AND gate, independent of the fanin order */
+inline uint64_t and_hash(uint64_t a, uint64_t b) {
+  if (a > b) {
+    std::swap(a, b);
+  }
+  return combine(combine(0xa17c0de5ull, a), b);
+}
+
+/* hash of a symmetric gate of the given kind, independent of the fanin order */
+template <std::size_t N>
+uint64_t gate_hash(uint64_t kind, std::array<uint64_t, N> fs) {
+  std::sort(fs.begin(), fs.end());
+  uint64_t h = kind;
+  for (auto f : fs) {
+    h = combine(h, f);
+  }
+  return h;
+}
+
+constexpr uint64_t const0_seed = 0x0c0c0c0c0c0c0c0cull;
+constexpr uint64_t ci_seed = 0x1f1f1f1f1f1f1f1full;
+
+}  // namespace detail
+
+/*! \brief Structural hashes.
+ *
+ * Every function computes its hash in a single topological pass.  The hash
+ * of a node depends only on its function and the hashes of its fanins, the
+ * hash of an input only on its position, so structurally identical networks
+ * get the same hash independent of their internal node numbering.
+ */
+inline uint64_t structural_hash(mockturtle::aig_network const &aig) {
+  std::vector<uint64_t> h(aig.size(), detail::const0_seed);
+
+  aig.foreach_pi([&](auto const &n, auto i) {
+    h[aig.node_to_index(n)] = detail::mix(detail::ci_seed + i);
+  });
+  aig.foreach_gate([&](auto const &n) {
+    std::array<uint64_t, 2> fs;
+    aig.foreach_fanin(n, [&](auto const &f, auto i) {
+      fs[i] = detail::edge(h[aig.node_to_index(aig.get_node(f))],
+                           aig.is_complemented(f));
+    });
+    h[aig.node_to_index(n)] = detail::and_hash(fs[0], fs[1]);
+  });
+
+  uint64_t result = detail::combine(aig.num_pis(), aig.num_pos());
+  aig.foreach_po([&](auto const &f) {
+    result = detail::combine(
+        result, detail::edge(h[aig.node_to_index(aig.get_node(f))],
+                             aig.is_complemented(f)));
+  });
+  return result;
+}
+
+/*! \brief Structural hash of MIGs, XAGs and XMGs.
+ *
+ * The gate kind is part of the node hash; an XAG without XOR gates hashes
+ * like the same AIG.
+ */
+template <class Ntk>
+uint64_t structural_hash_of(Ntk const &ntk) {
+  std::vector<uint64_t> h(ntk.size(), detail::const0_seed);
+
+  ntk.foreach_pi([&](auto const &n, auto i) {
+    h[ntk.node_to_index(n)] = detail::mix(detail::ci_seed + i);
+  });
+  ntk.foreach_gate([&](auto const &n) {
+    std::array<uint64_t, 3> fs{};
+    uint32_t num_fanins = 0u;
+    ntk.foreach_fanin(n, [&](auto const &f) {
+      fs[num_fanins++] = detail::edge(h[ntk.node_to_index(ntk.get_node(f))],
+                                      ntk.is_complemented(f));
+    });
+
+    uint64_t &hn = h[ntk.node_to_index(n)];
+    if (num_fanins == 2u) {
+      hn = ntk.is_xor(n) ? detail::gate_hash(0x0c0ffee5ull, std::array{fs[0], fs[1]})
+                         : detail::and_hash(fs[0], fs[1]);
+    } else {
+      hn = detail::gate_hash(ntk.is_maj(n) ? 0x3a7ull : 0x3c3ull, fs);
+    }
+  });
+
+  uint64_t result = detail::combine(ntk.num_pis(), ntk.num_pos());
+  ntk.foreach_po([&](auto const &f) {
+    result = detail::combine(
+        result, detail::edge(h[ntk.node_to_index(ntk.get_node(f))],
+                             ntk.is_complemented(f)));
+  });
+  return result;
+}
+
+inline uint64_t structural_hash(mockturtle::mig_network const &mig) {
+  return structural_hash_of(mig);
+}
+
+inline uint64_t structural_hash(mockturtle::xag_network const &xag) {
+  return structural_hash_of(xag);
+}
+
+inline uint64_t structural_hash(mockturtle::xmg_network const &xmg) {
+  return structural_hash_of(xmg);
+}
+
+inline uint64_t structural_hash(pabc::Gia_Man_t *gia) {
+  using namespace pabc; /* the iteration macros use unqualified names */
+  std::vector<uint64_t> h(pabc::Gia_ManObjNum(gia), detail::const0_seed);
+  pabc::Gia_Obj_t *pObj;
+  int i;
+
+  Gia_ManForEachCi(gia, pObj, i) {
+    h[pabc::Gia_ObjId(gia, pObj)] = detail::mix(detail::ci_seed + i);
+  }
+  Gia_ManForEachAnd(gia, pObj, i) {
+    h[i] = detail::and_hash(
+        detail::edge(h[pabc::Gia_ObjFaninId0(pObj, i)], pabc::Gia_ObjFaninC0(pObj)),
+        detail::edge(h[pabc::Gia_ObjFaninId1(pObj, i)], pabc::Gia_ObjFaninC1(pObj)));
+  }
+
+  uint64_t result = detail::combine(pabc::Gia_ManCiNum(gia), pabc::Gia_ManCoNum(gia));
+  result = detail::combine(result, pabc::Gia_ManRegNum(gia));
+  Gia_ManForEachCo(gia, pObj, i) {
+    result = detail::combine(
+        result, detail::edge(h[pabc::Gia_ObjFaninId0p(gia, pObj)],
+                             pabc::Gia_ObjFaninC0(pObj)));
+  }
+
+  /* a LUT mapping is part of the result of `&if` */
+  if (pabc::Gia_ManHasMapping(gia)) {
+    int k, iFan;
+    Gia_ManForEachLut(gia, i) {
+      result = detail::combine(result, h[i]);
+      Gia_LutForEachFanin(gia, i, iFan, k) {
+        result = detail::combine(result, h[iFan]);
+      }
+    }
+  }
+  return result;
+}
+
+/* Strashed networks hash AND gates, logic networks their SOPs and mapped
+ * networks their library gates; other node representations (BDDs, ...)
+ * only contribute their fanin structure. */
+inline uint64_t structural_hash(pabc::Abc_Ntk_t *pNtk) {
+  using namespace pabc; /* the iteration macros use unqualified names */
+  std::vector<uint64_t> h(pabc::Abc_NtkObjNumMax(pNtk), detail::const0_seed);
+  pabc::Abc_Obj_t *pObj;
+  int i;
+
+  Abc_NtkForEachCi(pNtk, pObj, i) {
+    h[pabc::Abc_ObjId(pObj)] = detail::mix(detail::ci_seed + i);
+  }
+
+  const bool strash = pabc::Abc_NtkIsStrash(pNtk);
+  /* choice nodes are dangling, only a full collection reaches them */
+  const bool choices = strash && pabc::Abc_NtkGetChoiceNum(pNtk) > 0;
+  pabc::Vec_Ptr_t *vNodes = pabc::Abc_NtkDfs(pNtk, choices);
+  Vec_PtrForEachEntry(pabc::Abc_Obj_t *, vNodes, pObj, i) {
+    const auto id = pabc::Abc_ObjId(pObj);
+    if (pabc::Abc_ObjFaninNum(pObj) == 0 && strash) {
+      continue;
+    }
+    if (strash) {
+      h[id] = detail::and_hash(
+          detail::edge(h[pabc::Abc_ObjFaninId0(pObj)], pabc::Abc_ObjFaninC0(pObj)),
+          detail::edge(h[pabc::Abc_ObjFaninId1(pObj)], pabc::Abc_ObjFaninC1(pObj)));
+      continue;
+    }
+
+    uint64_t node = 0u;
+    if (pabc::Abc_NtkHasSop(pNtk) && pObj->pData) {
+      const auto *sop = static_cast<char const *>(pObj->pData);
+      node = std::hash<std::string_view>{}(std::string_view(sop, std::strlen(sop)));
+    } else if (pabc::Abc_NtkHasMapping(pNtk)) {
+      node = reinterpret_cast<uint64_t>(pObj->pData);
+    }
+    pabc::Abc_Obj_t *pFanin;
+    int k;
+    Abc_ObjForEachFanin(pObj, pFanin, k) {
+      node = detail::combine(node, h[pabc::Abc_ObjId(pFanin)]);
+    }
+    h[id] = detail::mix(node);
+  }
+
+  uint64_t result = detail::combine(pabc::Abc_NtkCiNum(pNtk), pabc::Abc_NtkCoNum(pNtk));
+  if (choices) {
+    /* equivalence classes are linked through pData */
+    Vec_PtrForEachEntry(pabc::Abc_Obj_t *, vNodes, pObj, i) {
+      if (pObj->pData) {
+        auto *pNext = static_cast<pabc::Abc_Obj_t *>(pObj->pData);
+        result = detail::combine(
+            result, detail::combine(h[pabc::Abc_ObjId(pObj)], h[pabc::Abc_ObjId(pNext)]));
+      }
+    }
+  }
+  pabc::Vec_PtrFree(vNodes);
+
+  Abc_NtkForEachCo(pNtk, pObj, i) {
+    result = detail::combine(
+        result, detail::edge(h[pabc::Abc_ObjFaninId0(pObj)],
+                             strash && pabc::Abc_ObjFaninC0(pObj)));
+  }
+  return result;
+}
+
+/*! \brief Result of the last store update.
+ *
+ * Commands pushing a network with `extend_unique` record here whether the
+ * new entry differs structurally from the previous one; `store_hash`
+ * reports it.  Commands that push entries by other means leave it as it
+ * was, so `repeat` compares structural hashes itself.
+ */
+inline bool &last_store_changed() {
+  static bool changed = true;
+  return changed;
+}
+
+}  // namespace MagicLS
+
+#endif
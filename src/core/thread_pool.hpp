@@ -0,0 +1,114 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file thread_pool.hpp
+ *
+ * @brief  Fixed size thread pool for independent tasks
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/23
+ */
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace MagicLS {
+
+/*! \brief Runs submitted tasks on a fixed set of worker threads.
+ *
+ * Tasks are started in submission order.  Results and exceptions are
+ * delivered through the returned futures; the destructor finishes all
+ * queued tasks before joining the workers.
+ */
+class thread_pool {
+ public:
+  explicit thread_pool(uint32_t num_threads = 0u) {
+    if (num_threads == 0u) {
+      num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (auto i = 0u; i < num_threads; ++i) {
+      workers_.emplace_back([this]() { work(); });
+    }
+  }
+
+  thread_pool(thread_pool const &) = delete;
+  thread_pool &operator=(thread_pool const &) = delete;
+
+  ~thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    ready_.notify_all();
+    for (auto &w : workers_) {
+      w.join();
+    }
+  }
+
+  template <class Fn>
+  std::future<std::invoke_result_t<Fn>> submit(Fn &&fn) {
+    using result_t = std::invoke_result_t<Fn>;
+    auto task = std::make_shared<std::packaged_task<result_t()>>(std::forward<Fn>(fn));
+    auto future = task->get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.emplace([task]() { (*task)(); });
+    }
+    ready_.notify_one();
+    return future;
+  }
+
+  uint32_t size() const { return static_cast<uint32_t>(workers_.size()); }
+
+ private:
+  void work() {
+    for (;;) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+        if (tasks_.empty()) {
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop();
+      }
+      task();
+    }
+  }
+
+ private:
+  std::vector<std::thread> workers_;
+  std::queue<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  bool stop_ = false;
+};
+
+/*! \brief Lock held by worker threads while they call into ABC.
+ *
+ * ABC keeps the current networks and libraries in one global frame, so
+ * scripts from different threads must not overlap.
+ */
+inline std::mutex &abc_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+}  // namespace MagicLS
+
+#endif
@@ -0,0 +1,134 @@
+/* MagicLS: Magic Logic Synthesis
+ * Copyright (C) 2024 */
+
+/**
+ * @file truth_table_io.hpp
+ *
+ * @brief  Readers of truth table collections
+ *
+ * @author Jiaxiang Pan
+ * @since  2024/07/30
+ */
+
+#ifndef TRUTH_TABLE_IO_HPP
+#define TRUTH_TABLE_IO_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+
+namespace MagicLS {
+
+/* Non-empty lines of a text collection, without surrounding blanks; lines
+ * starting with '#' are comments. */
+inline std::vector<std::string_view> truth_table_lines(char const *data, std::size_t size) {
+  std::vector<std::string_view> lines;
+  std::string_view text(data, size);
+  while (!text.empty()) {
+    const auto end = std::min(text.find('\n'), text.size());
+    auto line = text.substr(0u, end);
+    text.remove_prefix(std::min(end + 1u, text.size()));
+
+    while (!line.empty() && std::isspace(static_cast<unsigned char>(line.front()))) {
+      line.remove_prefix(1u);
+    }
+    while (!line.empty() && std::isspace(static_cast<unsigned char>(line.back()))) {
+      line.remove_suffix(1u);
+    }
+    if (!line.empty() && line.front() != '#') {
+      lines.push_back(line);
+    }
+  }
+  return lines;
+}
+
+/*! \brief Parses one hex or binary truth table.
+ *
+ * The number of variables follows from the length as in `load`; hex
+ * strings may start with "0x".  Returns nullopt for invalid characters or
+ * lengths that are no power of two.
+ */
+inline std::optional<kitty::dynamic_truth_table> parse_truth_table(std::string_view text,
+                                                                   bool binary) {
+  if (!binary && text.size() > 2u && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+    text.remove_prefix(2u);
+  }
+  const auto num_bits = text.size() * (binary ? 1u : 4u);
+  if (text.empty() || (num_bits & (num_bits - 1u)) != 0u || num_bits > (1ull << 20u)) {
+    return std::nullopt;
+  }
+  for (auto c : text) {
+    if (binary ? (c != '0' && c != '1') : !std::isxdigit(static_cast<unsigned char>(c))) {
+      return std::nullopt;
+    }
+  }
+
+  uint32_t num_vars = 0u;
+  while ((1ull << num_vars) < num_bits) {
+    ++num_vars;
+  }
+  kitty::dynamic_truth_table tt(num_vars);
+  if (binary) {
+    kitty::create_from_binary_string(tt, std::string(text));
+  } else {
+    kitty::create_from_hex_string(tt, std::string(text));
+  }
+  return tt;
+}
+
+/*! \brief Packed binary collections.
+ *
+ * Format (little endian): "MLTT", u32 version, u32 num_vars, u64 #entries,
+ * then the words (u64) of every truth table; tables of fewer than 6
+ * variables take one word each.
+ */
+inline bool is_packed_truth_tables(char const *data, std::size_t size) {
+  return size >= 4u && std::memcmp(data, "MLTT", 4u) == 0;
+}
+
+inline std::optional<std::vector<kitty::dynamic_truth_table>>
+read_packed_truth_tables(char const *data, std::size_t size) {
+  constexpr uint32_t version = 1u;
+  constexpr std::size_t header = 4u + 4u + 4u + 8u;
+  if (!is_packed_truth_tables(data, size) || size < header) {
+    return std::nullopt;
+  }
+
+  uint32_t file_version = 0u, num_vars = 0u;
+  uint64_t count = 0u;
+  std::memcpy(&file_version, data + 4u, 4u);
+  std::memcpy(&num_vars, data + 8u, 4u);
+  std::memcpy(&count, data + 12u, 8u);
+  if (file_version != version || num_vars > 20u) {
+    return std::nullopt;
+  }
+
+  kitty::dynamic_truth_table tt(num_vars);
+  const auto words = tt.num_blocks();
+  if ((size - header) / (8u * words) < count) {
+    return std::nullopt;
+  }
+
+  std::vector<kitty::dynamic_truth_table> tts;
+  tts.reserve(count);
+  std::vector<uint64_t> buffer(words);
+  for (auto i = 0ull; i < count; ++i) {
+    std::memcpy(buffer.data(), data + header + i * 8u * words, 8u * words);
+    kitty::create_from_words(tt, buffer.begin(), buffer.end());
+    tt.mask_bits();
+    tts.push_back(tt);
+  }
+  return tts;
+}
+
+}  // namespace MagicLS
+
+#endif
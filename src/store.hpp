@@ -32,6 +32,10 @@
 #include <base/io/ioAbc.h>
 #include <fmt/format.h>
 
+#include <memory>
+#include <optional>
+#include <type_traits>
+
 #include <alice/alice.hpp>
 #include <kitty/kitty.hpp>
 #include <lorina/diagnostics.hpp>
@@ -42,12 +46,24 @@
 #include <mockturtle/io/write_blif.hpp>
 #include <mockturtle/io/write_verilog.hpp>
 #include <mockturtle/mockturtle.hpp>
+#include <mockturtle/views/binding_view.hpp>
 #include <mockturtle/views/names_view.hpp>
 
 #include "./core/abc2mockturtle.hpp"
+#include "./core/aiger_io.hpp"
+#include "./core/compressed_io.hpp"
+#include "./core/logic_readers.hpp"
 #include "./core/abc_api.hpp"
 #include "./core/abc_gia.hpp"
 #include "./core/abc.hpp"
+#include "./core/convert.hpp"
+#include "./core/exact_cache.hpp"
+#include "./core/npn.hpp"
+#include "./core/gia_lut.hpp"
+#include "./core/library_manager.hpp"
+#include "./core/memo_cache.hpp"
+#include "./core/store_stats.hpp"
+#include "./core/struct_hash.hpp"
 
 #include <mockturtle/algorithms/node_resynthesis.hpp>
 
@@ -121,10 +137,9 @@ ALICE_DESCRIBE_STORE(klut_network, element) {
 }
 
 ALICE_PRINT_STORE_STATISTICS(klut_network, os, lut) {
-  mockturtle::depth_view depth_lut{lut};
-  os << fmt::format("LUTs   i/o = {}/{}   gates = {}   level = {}",
-                    lut.num_pis(), lut.num_pos(), lut.num_gates(),
-                    depth_lut.depth());
+  const auto &st = MagicLS::cached_stats(lut);
+  os << fmt::format("LUTs   i/o = {}/{}   gates = {}   level = {}", st.pis,
+                    st.pos, st.gates, st.levels);
   os << "\n";
 }
 
@@ -139,16 +154,9 @@ class optimum_network {
   optimum_network(kitty::dynamic_truth_table &&function)
       : function(std::move(function)) {}
 
+  /* records the function in the dedup index, true if it was seen before */
   bool exists() const {
-    static std::vector<std::unordered_set<
-        kitty::dynamic_truth_table, kitty::hash<kitty::dynamic_truth_table>>>
-        hash;
-
-    if (function.num_vars() >= hash.size()) {
-      hash.resize(function.num_vars() + 1);
-    }
-
-    return !hash[function.num_vars()].insert(function).second;
+    return !MagicLS::function_index::instance().insert(function);
   }
 
  public: /* field access */
@@ -194,12 +202,13 @@ ALICE_DESCRIBE_STORE(std::vector<mockturtle::gate>, element) {
 ALICE_ADD_FILE_TYPE(genlib, "Genlib");
 
 ALICE_READ_FILE(std::vector<mockturtle::gate>, genlib, filename, cmd) {
-  std::vector<mockturtle::gate> gates;
-  if (lorina::read_genlib(filename, mockturtle::genlib_reader(gates)) !=
-      lorina::return_code::success) {
-    std::cout << "[w] parse error\n";
+  /* shared with abc_read_genlib, each library text is parsed once */
+  try {
+    return MagicLS::library_manager::instance().load(filename)->gates;
+  } catch (std::exception const &e) {
+    std::cout << "[w] " << e.what() << "\n";
+    return {};
   }
-  return gates;
 }
 
 ALICE_WRITE_FILE(std::vector<mockturtle::gate>, genlib, gates, filename, cmd) {
@@ -211,6 +220,71 @@ ALICE_PRINT_STORE_STATISTICS(std::vector<mockturtle::gate>, os, gates) {
   os << "\n";
 }
 
+/* mapped network */
+class mapped_network {
+ public:
+  using network_t = mockturtle::binding_view<mockturtle::klut_network>;
+
+  mapped_network() = default;
+
+  mapped_network(network_t const &ntk,
+                 std::shared_ptr<MagicLS::cell_library> library, double area,
+                 double delay)
+      : network(std::make_shared<network_t>(ntk)),
+        library(std::move(library)),
+        area(area),
+        delay(delay) {}
+
+ public: /* field access */
+  std::shared_ptr<network_t> network;
+  /* the bindings refer to the gates of this library */
+  std::shared_ptr<MagicLS::cell_library> library;
+  double area = 0.0;
+  double delay = 0.0;
+};
+
+ALICE_ADD_STORE(mapped_network, "mapped", "c", "mapped network",
+                "mapped networks")
+
+ALICE_DESCRIBE_STORE(mapped_network, element) {
+  if (!element.network) {
+    return std::string("empty");
+  }
+  return fmt::format("{} cells, area = {:.2f}, delay = {:.2f}",
+                     element.network->num_gates(), element.area, element.delay);
+}
+
+ALICE_PRINT_STORE(mapped_network, os, element) {
+  if (!element.network) {
+    os << "empty mapped network\n";
+    return;
+  }
+  os << fmt::format("Mapped PI/PO = {}/{}\n", element.network->num_pis(),
+                    element.network->num_pos());
+}
+
+ALICE_PRINT_STORE_STATISTICS(mapped_network, os, element) {
+  if (!element.network) {
+    os << "empty mapped network\n";
+    return;
+  }
+  os << fmt::format("Mapped   i/o = {}/{}   cells = {}   area = {:.2f}   delay = {:.2f}",
+                    element.network->num_pis(), element.network->num_pos(),
+                    element.network->num_gates(), element.area, element.delay);
+  os << "\n";
+}
+
+ALICE_LOG_STORE_STATISTICS(mapped_network, element) {
+  if (!element.network) {
+    return {};
+  }
+  return {{"inputs", element.network->num_pis()},
+          {"outputs", element.network->num_pos()},
+          {"cells", element.network->num_gates()},
+          {"area", element.area},
+          {"delay", element.delay}};
+}
+
 /********************************************************************
  * Read and Write                                                   *
  ********************************************************************/
@@ -218,29 +292,52 @@ ALICE_ADD_FILE_TYPE(aiger, "Aiger");
 
 ALICE_READ_FILE(aig_network, aiger, filename, cmd) {
   aig_network aig;
-  if (lorina::read_aiger(filename, mockturtle::aiger_reader(aig)) !=
-      lorina::return_code::success) {
+  try {
+    /* binary combinational AIGER is decoded from a memory mapping */
+    if (MagicLS::read_binary_aiger(filename, aig)) {
+      return aig;
+    }
+  } catch (std::exception const &e) {
+    std::cout << "[w] " << e.what() << "\n";
+    return aig;
+  }
+
+  if (MagicLS::parse_file(filename, [&](std::istream &in) {
+        return lorina::read_aiger(in, mockturtle::aiger_reader(aig));
+      }) != lorina::return_code::success) {
     std::cout << "[w] parse error\n";
   }
   return aig;
 }
 
 ALICE_PRINT_STORE_STATISTICS(aig_network, os, aig) {
-  auto aig_copy = mockturtle::cleanup_dangling(aig);
-  mockturtle::depth_view depth_aig{aig_copy};
+  const auto &st = MagicLS::cached_stats(aig);
   os << fmt::format("AIG   i/o = {}/{}   gates = {}   level = {}",
-                    aig.num_pis(), aig.num_pos(), aig.num_gates(),
-                    depth_aig.depth());
+                    st.pis, st.pos, st.gates, st.levels);
+  os << "\n";
+  os << fmt::format("      dangling = {}   fanout histogram = {}", st.dangling,
+                    MagicLS::to_string(st.fanout_histogram));
   os << "\n";
 }
 
+ALICE_LOG_STORE_STATISTICS(aig_network, aig) {
+  const auto &st = MagicLS::cached_stats(aig);
+  return {{"inputs", st.pis},
+          {"outputs", st.pos},
+          {"gates", st.gates},
+          {"levels", st.levels},
+          {"dangling", st.dangling},
+          {"fanouts", st.fanout_histogram}};
+}
+
 ALICE_ADD_FILE_TYPE(verilog, "Verilog");
 
 ALICE_READ_FILE(aig_network, verilog, filename, cmd) {
   aig_network aig;
 
-  if (lorina::read_verilog(filename, mockturtle::verilog_reader(aig)) !=
-      lorina::return_code::success) {
+  if (MagicLS::parse_file(filename, [&](std::istream &in) {
+        return lorina::read_verilog(in, mockturtle::verilog_reader(aig));
+      }) != lorina::return_code::success) {
     std::cout << "[w] parse error\n";
   }
   return aig;
@@ -249,56 +346,87 @@ ALICE_READ_FILE(aig_network, verilog, filename, cmd) {
 ALICE_READ_FILE(xmg_network, verilog, filename, cmd) {
   xmg_network xmg;
 
-  if (lorina::read_verilog(filename, mockturtle::verilog_reader(xmg)) !=
-      lorina::return_code::success) {
+  if (MagicLS::parse_file(filename, [&](std::istream &in) {
+        return lorina::read_verilog(in, mockturtle::verilog_reader(xmg));
+      }) != lorina::return_code::success) {
     std::cout << "[w] parse error\n";
   }
   return xmg;
 }
 
 ALICE_WRITE_FILE(xmg_network, verilog, xmg, filename, cmd) {
-  mockturtle::write_verilog(xmg, filename);
+  MagicLS::write_file(filename, [&](std::ostream &os) {
+    mockturtle::write_verilog(xmg, os);
+  });
 }
 
 ALICE_WRITE_FILE(aig_network, verilog, aig, filename, cmd) {
-  mockturtle::write_verilog(aig, filename);
+  MagicLS::write_file(filename, [&](std::ostream &os) {
+    mockturtle::write_verilog(aig, os);
+  });
 }
 
 ALICE_PRINT_STORE_STATISTICS(xmg_network, os, xmg) {
-  auto xmg_copy = mockturtle::cleanup_dangling(xmg);
-  mockturtle::depth_view depth_xmg{xmg_copy};
+  const auto &st = MagicLS::cached_stats(xmg);
   os << fmt::format("XMG   i/o = {}/{}   gates = {}   level = {}",
-                    xmg.num_pis(), xmg.num_pos(), xmg.num_gates(),
-                    depth_xmg.depth());
+                    st.pis, st.pos, st.gates, st.levels);
   os << "\n";
+  os << fmt::format("      dangling = {}   fanout histogram = {}", st.dangling,
+                    MagicLS::to_string(st.fanout_histogram));
+  os << "\n";
+}
+
+ALICE_LOG_STORE_STATISTICS(xmg_network, xmg) {
+  const auto &st = MagicLS::cached_stats(xmg);
+  return {{"inputs", st.pis},
+          {"outputs", st.pos},
+          {"gates", st.gates},
+          {"levels", st.levels},
+          {"dangling", st.dangling},
+          {"fanouts", st.fanout_histogram}};
 }
 
 ALICE_READ_FILE(mig_network, verilog, filename, cmd) {
   mig_network mig;
-  if (lorina::read_verilog(filename, mockturtle::verilog_reader(mig)) !=
-      lorina::return_code::success) {
+  if (MagicLS::parse_file(filename, [&](std::istream &in) {
+        return lorina::read_verilog(in, mockturtle::verilog_reader(mig));
+      }) != lorina::return_code::success) {
     std::cout << "[w] parse error\n";
   }
   return mig;
 }
 
 ALICE_WRITE_FILE(mig_network, verilog, mig, filename, cmd) {
-  mockturtle::write_verilog(mig, filename);
+  MagicLS::write_file(filename, [&](std::ostream &os) {
+    mockturtle::write_verilog(mig, os);
+  });
 }
 
 ALICE_PRINT_STORE_STATISTICS(mig_network, os, mig) {
-  auto mig_copy = mockturtle::cleanup_dangling(mig);
-  mockturtle::depth_view depth_mig{mig_copy};
+  const auto &st = MagicLS::cached_stats(mig);
   os << fmt::format("MIG   i/o = {}/{}   gates = {}   level = {}",
-                    mig.num_pis(), mig.num_pos(), mig.num_gates(),
-                    depth_mig.depth());
+                    st.pis, st.pos, st.gates, st.levels);
+  os << "\n";
+  os << fmt::format("      dangling = {}   fanout histogram = {}", st.dangling,
+                    MagicLS::to_string(st.fanout_histogram));
   os << "\n";
 }
 
+ALICE_LOG_STORE_STATISTICS(mig_network, mig) {
+  const auto &st = MagicLS::cached_stats(mig);
+  return {{"inputs", st.pis},
+          {"outputs", st.pos},
+          {"gates", st.gates},
+          {"levels", st.levels},
+          {"dangling", st.dangling},
+          {"fanouts", st.fanout_histogram}};
+}
+
 ALICE_READ_FILE(xag_network, verilog, filename, cmd) {
   xag_network xag;
-  if (lorina::read_verilog(filename, mockturtle::verilog_reader(xag)) !=
-      lorina::return_code::success) {
+  if (MagicLS::parse_file(filename, [&](std::istream &in) {
+        return lorina::read_verilog(in, mockturtle::verilog_reader(xag));
+      }) != lorina::return_code::success) {
     std::cout << "[w] parse error\n";
   }
 
@@ -306,51 +434,117 @@ ALICE_READ_FILE(xag_network, verilog, filename, cmd) {
 }
 
 ALICE_WRITE_FILE(xag_network, verilog, xag, filename, cmd) {
-  mockturtle::write_verilog(xag, filename);
+  MagicLS::write_file(filename, [&](std::ostream &os) {
+    mockturtle::write_verilog(xag, os);
+  });
+}
+
+ALICE_WRITE_FILE(mapped_network, verilog, element, filename, cmd) {
+  if (!element.network) {
+    std::cout << "[e] empty mapped network\n";
+    return;
+  }
+  MagicLS::write_file(filename, [&](std::ostream &os) {
+    mockturtle::write_verilog_with_binding(*element.network, os);
+  });
 }
 
 ALICE_PRINT_STORE_STATISTICS(xag_network, os, xag) {
-  auto xag_copy = mockturtle::cleanup_dangling(xag);
-  mockturtle::depth_view depth_xag{xag_copy};
+  const auto &st = MagicLS::cached_stats(xag);
   os << fmt::format("XAG   i/o = {}/{}   gates = {}   level = {}",
-                    xag.num_pis(), xag.num_pos(), xag.num_gates(),
-                    depth_xag.depth());
+                    st.pis, st.pos, st.gates, st.levels);
+  os << "\n";
+  os << fmt::format("      dangling = {}   fanout histogram = {}", st.dangling,
+                    MagicLS::to_string(st.fanout_histogram));
   os << "\n";
 }
 
+ALICE_LOG_STORE_STATISTICS(xag_network, xag) {
+  const auto &st = MagicLS::cached_stats(xag);
+  return {{"inputs", st.pis},
+          {"outputs", st.pos},
+          {"gates", st.gates},
+          {"levels", st.levels},
+          {"dangling", st.dangling},
+          {"fanouts", st.fanout_histogram}};
+}
+
 ALICE_ADD_FILE_TYPE(bench, "BENCH");
 
 ALICE_READ_FILE(klut_network, bench, filename, cmd) {
   klut_network klut;
-  if (lorina::read_bench(filename, mockturtle::bench_reader(klut)) !=
-      lorina::return_code::success) {
+  if (MagicLS::parse_file(filename, [&](std::istream &in) {
+        return lorina::read_bench(in, mockturtle::bench_reader(klut));
+      }) != lorina::return_code::success) {
     std::cout << "[w] parse error\n";
   }
   return klut;
 }
 
+ALICE_READ_FILE(aig_network, bench, filename, cmd) {
+  aig_network aig;
+  if (MagicLS::parse_file(filename, [&](std::istream &in) {
+        MagicLS::logic_bench_reader<aig_network> reader(aig);
+        const auto rc = lorina::read_bench(in, reader);
+        return rc == lorina::return_code::success && reader.finalize()
+                   ? rc
+                   : lorina::return_code::parse_error;
+      }) != lorina::return_code::success) {
+    std::cout << "[w] parse error\n";
+  }
+  return aig;
+}
+
+ALICE_READ_FILE(xag_network, bench, filename, cmd) {
+  xag_network xag;
+  if (MagicLS::parse_file(filename, [&](std::istream &in) {
+        MagicLS::logic_bench_reader<xag_network> reader(xag);
+        const auto rc = lorina::read_bench(in, reader);
+        return rc == lorina::return_code::success && reader.finalize()
+                   ? rc
+                   : lorina::return_code::parse_error;
+      }) != lorina::return_code::success) {
+    std::cout << "[w] parse error\n";
+  }
+  return xag;
+}
+
 ALICE_WRITE_FILE(xmg_network, bench, xmg, filename, cmd) {
-  mockturtle::write_bench(xmg, filename);
+  MagicLS::write_file(filename, [&](std::ostream &os) {
+    mockturtle::write_bench(xmg, os);
+  });
 }
 
 ALICE_WRITE_FILE(mig_network, bench, mig, filename, cmd) {
-  mockturtle::write_bench(mig, filename);
+  MagicLS::write_file(filename, [&](std::ostream &os) {
+    mockturtle::write_bench(mig, os);
+  });
 }
 
 ALICE_WRITE_FILE(aig_network, bench, aig, filename, cmd) {
-  mockturtle::write_bench(aig, filename);
+  MagicLS::write_file(filename, [&](std::ostream &os) {
+    mockturtle::write_bench(aig, os);
+  });
 }
 
 ALICE_WRITE_FILE(xag_network, bench, xag, filename, cmd) {
-  mockturtle::write_bench(xag, filename);
+  MagicLS::write_file(filename, [&](std::ostream &os) {
+    mockturtle::write_bench(xag, os);
+  });
 }
 
 ALICE_WRITE_FILE(klut_network, bench, klut, filename, cmd) {
-  mockturtle::write_bench(klut, filename);
+  MagicLS::write_file(filename, [&](std::ostream &os) {
+    mockturtle::write_bench(klut, os);
+  });
 }
 
 ALICE_WRITE_FILE(aig_network, aiger, aig, filename, cmd) {
-  mockturtle::write_aiger(aig, filename);
+  try {
+    MagicLS::write_binary_aiger(aig, filename);
+  } catch (std::exception const &e) {
+    std::cout << "[e] " << e.what() << "\n";
+  }
 }
 
 ALICE_ADD_FILE_TYPE(blif, "Blif");
@@ -358,92 +552,103 @@ ALICE_ADD_FILE_TYPE(blif, "Blif");
 ALICE_READ_FILE(klut_network, blif, filename, cmd) {
   klut_network klut;
 
-  if (lorina::read_blif(filename, mockturtle::blif_reader(klut)) !=
-      lorina::return_code::success) {
+  if (MagicLS::parse_file(filename, [&](std::istream &in) {
+        return lorina::read_blif(in, mockturtle::blif_reader(klut));
+      }) != lorina::return_code::success) {
     std::cout << "[w] parse error\n";
   }
 
   return klut;
 }
 
+ALICE_READ_FILE(aig_network, blif, filename, cmd) {
+  aig_network aig;
+  if (MagicLS::parse_file(filename, [&](std::istream &in) {
+        MagicLS::logic_blif_reader<aig_network> reader(aig);
+        const auto rc = lorina::read_blif(in, reader);
+        return rc == lorina::return_code::success && reader.finalize()
+                   ? rc
+                   : lorina::return_code::parse_error;
+      }) != lorina::return_code::success) {
+    std::cout << "[w] parse error\n";
+  }
+  return aig;
+}
+
+ALICE_READ_FILE(xag_network, blif, filename, cmd) {
+  xag_network xag;
+  if (MagicLS::parse_file(filename, [&](std::istream &in) {
+        MagicLS::logic_blif_reader<xag_network> reader(xag);
+        const auto rc = lorina::read_blif(in, reader);
+        return rc == lorina::return_code::success && reader.finalize()
+                   ? rc
+                   : lorina::return_code::parse_error;
+      }) != lorina::return_code::success) {
+    std::cout << "[w] parse error\n";
+  }
+  return xag;
+}
+
 ALICE_WRITE_FILE(xmg_network, blif, xmg, filename, cmd) {
-  mockturtle::write_blif(xmg, filename);
+  MagicLS::write_file(filename, [&](std::ostream &os) {
+    mockturtle::write_blif(xmg, os);
+  });
 }
 
 ALICE_WRITE_FILE(klut_network, blif, klut, filename, cmd) {
-  mockturtle::write_blif(klut, filename);
+  MagicLS::write_file(filename, [&](std::ostream &os) {
+    mockturtle::write_blif(klut, os);
+  });
 }
 
 /********************************************************************
  * Convert from aig to mig                                          *
  ********************************************************************/
 ALICE_CONVERT(aig_network, element, mig_network) {
-  aig_network aig = element;
-
-  /* LUT mapping */
-  mapping_view<aig_network, true> mapped_aig{aig};
-  lut_mapping_params ps;
-  ps.cut_enumeration_ps.cut_size = 4;
-  lut_mapping<mapping_view<aig_network, true>, true>(mapped_aig, ps);
-
-  /* collapse into k-LUT network */
-  const auto klut = *collapse_mapped_network<klut_network>(mapped_aig);
+  if (MagicLS::convert_ps().fast) {
+    return MagicLS::direct_convert<mig_network>(element);
+  }
 
-  /* node resynthesis */
+  /* LUT mapping, collapsing and node resynthesis */
   mig_npn_resynthesis resyn;
-  auto mig = node_resynthesis<mig_network>(klut, resyn);
-
-  return mig;
+  return MagicLS::lut_resynthesis_convert<mig_network>(
+      element, resyn, MagicLS::npn_cut_size());
 }
 
 /********************************************************************
  * Convert from aig to xag                                          *
  ********************************************************************/
-ALICE_CONVERT(aig_network, element, xag_network){
-  aig_network aig = element;
-
-  /* LUT mapping */
-  mapping_view<aig_network, true> mapped_aig{aig};
-  lut_mapping_params ps;
-  ps.cut_enumeration_ps.cut_size = 4;
-  lut_mapping<mapping_view<aig_network, true>, true>(mapped_aig, ps);
-
-  /* collapse into k-LUT network */
-  const auto klut = *collapse_mapped_network<klut_network>(mapped_aig);
+ALICE_CONVERT(aig_network, element, xag_network) {
+  if (MagicLS::convert_ps().fast) {
+    return MagicLS::direct_convert<xag_network>(element);
+  }
 
-  /* node resynthesis */
+  /* LUT mapping, collapsing and node resynthesis */
   xag_npn_resynthesis<xag_network> resyn;
-  auto xag = node_resynthesis<xag_network>(klut, resyn);
-
-  return xag;
+  return MagicLS::lut_resynthesis_convert<xag_network>(
+      element, resyn, MagicLS::npn_cut_size());
 }
 
 /********************************************************************
  * Convert from xmg to aig                                          *
  ********************************************************************/
-ALICE_CONVERT(xmg_network, element, aig_network){
-  xmg_network xmg = element;
-
-  /* LUT mapping */
-  mapping_view<xmg_network, true> mapped_xmg{xmg};
-  lut_mapping_params ps;
-  ps.cut_enumeration_ps.cut_size = 4;
-  lut_mapping<mapping_view<xmg_network, true>, true>(mapped_xmg, ps);
-
-  /* collapse into k-LUT network */
-  const auto klut = *collapse_mapped_network<klut_network>(mapped_xmg);
+ALICE_CONVERT(xmg_network, element, aig_network) {
+  if (MagicLS::convert_ps().fast) {
+    return MagicLS::direct_convert<aig_network>(element);
+  }
 
-  /* node resynthesis */
+  /* LUT mapping, collapsing and node resynthesis */
   exact_resynthesis_params ps2;
   ps2.cache = std::make_shared<exact_resynthesis_params::cache_map_t>();
   exact_aig_resynthesis<aig_network> exact_resyn(false, ps2);
-  node_resynthesis_stats nrst;
-  dsd_resynthesis<aig_network, decltype(exact_resyn)> resyn(exact_resyn);
+  /* exact synthesis results are shared by all conversions per NPN class */
+  MagicLS::npn_cached_resynthesis<aig_network, decltype(exact_resyn)>
+      cached_resyn(exact_resyn);
   //DSD decomposition may not be able to decompose the whole truth table, \
   a different fall-back resynthesis function must be passed to this function
-  const auto aig = node_resynthesis<aig_network>(klut, resyn, {}, &nrst);
-
-  return aig;
+  dsd_resynthesis<aig_network, decltype(cached_resyn)> resyn(cached_resyn);
+  return MagicLS::lut_resynthesis_convert<aig_network>(
+      element, resyn, MagicLS::convert_ps().cut_size);
 }
 
 /* show */
@@ -521,58 +726,36 @@ void show<xag_network>(std::ostream &os, const xag_network &element,
  * Convert from aig to xmg                                          *
  ********************************************************************/
 ALICE_CONVERT(aig_network, element, xmg_network) {
-  aig_network aig = element;
-
-  /* LUT mapping */
-  mapping_view<aig_network, true> mapped_aig{aig};
-  lut_mapping_params ps;
-  ps.cut_enumeration_ps.cut_size = 4;
-  lut_mapping<mapping_view<aig_network, true>, true>(mapped_aig, ps);
-
-  /* collapse into k-LUT network */
-  const auto klut = *collapse_mapped_network<klut_network>(mapped_aig);
+  if (MagicLS::convert_ps().fast) {
+    return MagicLS::direct_convert<xmg_network>(element);
+  }
 
-  /* node resynthesis */
+  /* LUT mapping, collapsing and node resynthesis */
   xmg_npn_resynthesis resyn;
-  auto xmg = node_resynthesis<xmg_network>(klut, resyn);
-
-  return xmg;
+  return MagicLS::lut_resynthesis_convert<xmg_network>(
+      element, resyn, MagicLS::npn_cut_size());
 }
 
 ALICE_CONVERT(mig_network, element, xmg_network) {
-  mig_network mig = element;
-
-  /* LUT mapping */
-  mapping_view<mig_network, true> mapped_mig{mig};
-  lut_mapping_params ps;
-  ps.cut_enumeration_ps.cut_size = 4;
-  lut_mapping<mapping_view<mig_network, true>, true>(mapped_mig, ps);
-
-  /* collapse into k-LUT network */
-  const auto klut = *collapse_mapped_network<klut_network>(mapped_mig);
+  if (MagicLS::convert_ps().fast) {
+    return MagicLS::direct_convert<xmg_network>(element);
+  }
 
-  /* node resynthesis */
+  /* LUT mapping, collapsing and node resynthesis */
   xmg_npn_resynthesis resyn;
-  auto xmg = node_resynthesis<xmg_network>(klut, resyn);
-  return xmg;
+  return MagicLS::lut_resynthesis_convert<xmg_network>(
+      element, resyn, MagicLS::npn_cut_size());
 }
 
 ALICE_CONVERT(xmg_network, element, mig_network) {
-  xmg_network xmg = element;
-
-  /* LUT mapping */
-  mapping_view<xmg_network, true> mapped_xmg{xmg};
-  lut_mapping_params ps;
-  ps.cut_enumeration_ps.cut_size = 4;
-  lut_mapping<mapping_view<xmg_network, true>, true>(mapped_xmg, ps);
-
-  /* collapse into k-LUT network */
-  const auto klut = *collapse_mapped_network<klut_network>(mapped_xmg);
+  if (MagicLS::convert_ps().fast) {
+    return MagicLS::direct_convert<mig_network>(element);
+  }
 
-  /* node resynthesis */
+  /* LUT mapping, collapsing and node resynthesis */
   mig_npn_resynthesis resyn;
-  auto mig = node_resynthesis<mig_network>(klut, resyn);
-  return mig;
+  return MagicLS::lut_resynthesis_convert<mig_network>(
+      element, resyn, MagicLS::npn_cut_size());
 }
 
 /* ABC aiger */
@@ -582,6 +765,10 @@ ALICE_DESCRIBE_STORE(pabc::Abc_Ntk_t *, abc) {
   const auto name = pabc::Abc_NtkName(abc);
   const auto pi_num = pabc::Abc_NtkPiNum(abc);
   const auto po_num = pabc::Abc_NtkPoNum(abc);
+  if (pabc::Abc_NtkIsStrash(abc) && pabc::Abc_NtkGetChoiceNum(abc) > 0) {
+    return fmt::format("{}   i/o = {}/{}   choices = {}", name, pi_num, po_num,
+                       pabc::Abc_NtkGetChoiceNum(abc));
+  }
   return fmt::format("{}   i/o = {}/{}", name, pi_num, po_num);
 }
 
@@ -652,8 +839,12 @@ ALICE_DESCRIBE_STORE(pabc::Gia_Man_t *, gia) {
   const auto pi_num = pabc::Gia_ManPiNum(gia);
   const auto po_num = pabc::Gia_ManPoNum(gia);
   const auto gates_num = pabc::Gia_ManAndNum(gia);
-  const auto level = pabc::Gia_ManLevelNum(gia);
+  const auto level = MagicLS::cached_gia_levels(gia);
   // return fmt::format("{}   i/o = {}/{}", name, pi_num, po_num);
+  if (pabc::Gia_ManHasChoices(gia)) {
+    return fmt::format("[GIA]   i/o = {}/{}  nodes = {}  level = {}  choices = {}",
+                       pi_num, po_num, gates_num, level, pabc::Gia_ManChoiceNum(gia));
+  }
   return fmt::format("[GIA]   i/o = {}/{}  nodes = {}  level = {}", pi_num, po_num, gates_num, level);
 }
 
@@ -672,17 +863,51 @@ ALICE_LOG_STORE_STATISTICS(pabc::Gia_Man_t *, gia) {
           {"inputs", pabc::Gia_ManPiNum(gia)},
           {"outputs", pabc::Gia_ManPoNum(gia)},
           {"nodes", pabc::Gia_ManAndNum(gia)},
-          {"levels", pabc::Gia_ManLevelNum(gia)}};
+          {"levels", MagicLS::cached_gia_levels(gia)}};
 }
 
 ALICE_ADD_FILE_TYPE(gia, "Gia");
 
+/* like the other readers, a failed read gives an empty network: alice
+ * stores whatever is returned and GIA commands expect a manager */
 ALICE_READ_FILE(pabc::Gia_Man_t *, gia, filename, cmd) {
-  return pabc::Gia_AigerRead((char *)filename.c_str(), 0, 0, 0);
+  pabc::Gia_Man_t *gia = nullptr;
+  if (MagicLS::compression_of(filename) == MagicLS::compression::none) {
+    gia = pabc::Gia_AigerRead((char *)filename.c_str(), 0, 0, 0);
+  } else {
+    try {
+      auto contents = MagicLS::read_file_contents(filename);
+      gia = pabc::Gia_AigerReadFromMemory(contents.data(),
+                                          static_cast<int>(contents.size()), 0, 0, 0);
+    } catch (std::exception const &e) {
+      std::cout << "[w] " << e.what() << "\n";
+    }
+  }
+  if (gia == nullptr) {
+    std::cout << "[w] parse error\n";
+    gia = pabc::Gia_ManStart(1);
+  }
+  return gia;
 }
 
 ALICE_WRITE_FILE(pabc::Gia_Man_t *, gia, gia, filename, cmd) {
-  pabc::Gia_AigerWrite(gia, (char *)filename.c_str(), 1, 0, 0);
+  if (MagicLS::compression_of(filename) == MagicLS::compression::none) {
+    pabc::Gia_AigerWrite(gia, (char *)filename.c_str(), 1, 0, 0);
+    return;
+  }
+  pabc::Vec_Str_t *vStr = pabc::Gia_AigerWriteIntoMemoryStr(gia);
+  MagicLS::write_file(filename, [&](std::ostream &os) {
+    os.write(pabc::Vec_StrArray(vStr), pabc::Vec_StrSize(vStr));
+  });
+  pabc::Vec_StrFree(vStr);
+}
+
+/* the cell bindings are dropped, each cell becomes a LUT of its function */
+ALICE_CONVERT(mapped_network, element, klut_network) {
+  if (!element.network) {
+    return klut_network();
+  }
+  return static_cast<klut_network const &>(*element.network);
 }
 
 /* gia */
@@ -705,6 +930,79 @@ ALICE_CONVERT(pabc::Gia_Man_t *, element, aig_network) {
   return aig;
 }
 
+/* keeps the LUT mapping of `&if` and friends */
+ALICE_CONVERT(pabc::Gia_Man_t *, element, klut_network) {
+  return MagicLS::gia_to_klut(element);
+}
+
+/********************************************************************
+ * Store updates                                                    *
+ ********************************************************************/
+namespace detail {
+inline void release_network(aig_network const &) {}
+inline void release_network(pabc::Abc_Ntk_t *pNtk) { pabc::Abc_NtkDelete(pNtk); }
+inline void release_network(pabc::Gia_Man_t *gia) { MagicLS::release_gia(gia); }
+}  // namespace detail
+
+/* Pushes `ntk` as a new entry of `st`.  If it is structurally identical to
+ * the current entry, the new entry shares the current network (AIG storages
+ * are reference counted, the current ABC/GIA pointer is pushed again) and
+ * the duplicate is released unless another entry still refers to it.  ABC
+ * and GIA pointers are therefore owned by the store once passed here: never
+ * pass a network that is still owned elsewhere, such as the GIA of the ABC
+ * frame (`Abc_FrameGetGia`), push a copy of it instead.  In-place passes
+ * pass the hash of the network taken before they ran as `before`.
+ *
+ * Only the current entry is compared: a pass that returns to an older
+ * network gets a new entry of its own.  Deduplicating against the whole
+ * store would need a hash index kept in sync with every store command and
+ * reference counts on the shared ABC/GIA pointers, which is out of scope.
+ * Returns whether the network changed with respect to the current entry. */
+template <typename T>
+bool extend_unique(store_container<T> &st, T ntk,
+                   std::optional<uint64_t> before = std::nullopt) {
+  bool changed = true;
+  if (st.size() != 0u) {
+    T current = st.current();
+    changed = (before ? *before : MagicLS::structural_hash(current)) !=
+              MagicLS::structural_hash(ntk);
+
+    if (!changed) {
+      if constexpr (std::is_pointer_v<T>) {
+        bool referenced = ntk == current;
+        for (auto i = 0u; i < st.size() && !referenced; ++i) {
+          referenced = st[i] == ntk;
+        }
+        if (!referenced) {
+          detail::release_network(ntk);
+        }
+      }
+      ntk = current;
+      std::cout << "[i] network unchanged\n";
+    }
+  }
+
+  st.extend();
+  st.current() = ntk;
+  MagicLS::last_store_changed() = changed;
+  return changed;
+}
+
+/* Pushes the memoized result of `command` on the network with hash
+ * `before`, if memoization is enabled and has one.  Returns whether it did;
+ * on false the caller runs the command and records it with `insert`. */
+template <typename T>
+bool extend_memoized(store_container<T> &st, uint64_t before,
+                     std::string const &command) {
+  auto hit = MagicLS::memo_cache<T>::instance().lookup(before, command);
+  if (!hit) {
+    return false;
+  }
+  std::cout << "[i] memo hit: " << command << "\n";
+  extend_unique(st, *hit, before);
+  return true;
+}
+
 }  // namespace alice
 
 #endif